@@ -41,6 +41,7 @@
  */
 
 #include <pthread.h>  // pthread_t, pthread_mutex_init(), pthread_create()
+#include <signal.h>   // sigaction(), SIGUSR1, sig_atomic_t
 #include <stdio.h>    // getchar()
 
 #include <cstring>   // memset()
@@ -56,18 +57,47 @@
 
 #include <somatic.pb-c.h>  // SOMATIC__: EVENT, MOTOR_PARAM; Somatic__WaistMode
 #include <somatic/daemon.h>  // somatic_d: t, t_opts, _init(), _event(), _destroy()
-#include <somatic/motor.h>  // somatic_motor_cmd()
 #include <somatic/msg.h>  // somatic_anything_alloc(), somatic_anything_free(), Somatic_KrangPoseParams
 #include <somatic/util.h>  // somatic_sig_received
 
+#include "balancing/alloc_guard.h"  // AllocGuardArm(), AllocGuardDisarm()
 #include "balancing/arms.h"  // ArmControl
-#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams(), ReadConfigTimeStep()
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigTimeStep()
+#include "balancing/config_cache.h"  // ReadConfigParamsCached()
+#include "balancing/config_watcher.h"  // ConfigWatcher
 #include "balancing/control.h"   // BalanceControl
+#include "balancing/hardware_interface.h"  // HardwareInterface
 #include "balancing/events.h"    // Events()
-#include "balancing/joystick.h"  // Joystick
+#include "balancing/flight_recorder.h"  // FlightRecorder, FlightRecord
+#include "balancing/joystick.h"  // JoystickShared, JoystickThread
 #include "balancing/keyboard.h"  // KbShared, KbHit
-#include "balancing/torso.h"     // TorsoState, ControlTorso()
-#include "balancing/waist.h"     // ControlWaist()
+#include "balancing/krang_hardware_interface.h"  // KrangHardwareInterface
+#include "balancing/logger.h"    // Logger, LogRecord
+#include "balancing/rt_setup.h"  // SetupRtProcess(), SetupRtControlThread()
+#include "balancing/sim_hardware_interface.h"  // SimHardwareInterface
+#include "balancing/loop_timer.h"  // LoopTimer
+#include "balancing/tick_profiler.h"  // TickProfiler
+#include "balancing/torso.h"     // TorsoState
+#include "balancing/upper_body.h"  // UpperBodyExecutor
+
+/* ************************************************************************* */
+// Stages of an iteration of the main loop that are timed by the profiler
+enum LoopStage {
+  kUpdateState = 0,
+  kEvents,
+  kBalancingController,
+  kWheelCommand,
+  kUpperBody,
+  kSimStep,
+  kNumLoopStages
+};
+const char* const kLoopStageNames[] = {
+    "UpdateState",   "Events",     "BalancingController",
+    "wheel command", "upper body", "sim step"};
+
+// Set by SIGUSR1 to ask the main loop to dump the latency histograms
+volatile sig_atomic_t latency_dump_requested = 0;
+void RequestLatencyDump(int) { latency_dump_requested = 1; }
 
 /* ************************************************************************* */
 /// The main thread
@@ -87,17 +117,24 @@ int main(int argc, char* argv[]) {
     return 0;
 
   // Read config parameters
-  ReadConfigParams(
+  const char* config_file =
       (params.is_simulation_
            ? "/usr/local/share/krang/balancing/cfg/"
              "balancing_params_simulation.cfg"
-           : "/usr/local/share/krang/balancing/cfg/balancing_params.cfg"),
-      &params);
+           : "/usr/local/share/krang/balancing/cfg/balancing_params.cfg");
+  Eigen::MatrixXd beta;  ///< CoM parameters at params.comParametersPath
+  ReadConfigParamsCached(config_file, &params, &beta);
+
+  // Lock and prefault memory before anything else is loaded, and have all
+  // threads start on the auxiliary cpus
+  bool rt_ready = SetupRtProcess(params);
 
-  // If simulation mode, create interface to the world of simulation
+  // If simulation mode, create interface to the world of simulation, unless
+  // the robot is simulated in this process
+  bool in_process_sim = (params.is_simulation_ && params.inProcessSimulation);
   InterfaceContext* interface_context;
   WorldInterface* world_interface;
-  if (params.is_simulation_) {
+  if (params.is_simulation_ && !in_process_sim) {
     interface_context = new InterfaceContext("01-balance-sim-interface");
     world_interface =
         new WorldInterface(*interface_context, "sim-cmd", "sim-state");
@@ -128,8 +165,10 @@ int main(int argc, char* argv[]) {
       delete interface_context;
       return 0;
     }
+  }
 
-    // Get the time of the simulation
+  // Get the time step of the simulation
+  if (params.is_simulation_) {
     params.sim_dt_ = ReadConfigTimeStep(
         "/usr/local/share/krang-sim-ach/cfg/dart_params.cfg");
     if (params.sim_dt_ < 0.0) {
@@ -158,14 +197,27 @@ int main(int argc, char* argv[]) {
   world->addSkeleton(robot);
 
   // Initialize the motors and sensors on the hardware and update the kinematics
-  // in dart
-  int hw_mode = Krang::Hardware::MODE_AMC | Krang::Hardware::MODE_LARM |
-                Krang::Hardware::MODE_RARM | Krang::Hardware::MODE_TORSO |
-                Krang::Hardware::MODE_WAIST;
-  Krang::Hardware*
-      krang;  ///< Interface for the motor and sensors on the hardware
-  krang =
-      new Krang::Hardware((Krang::Hardware::Mode)hw_mode, &daemon_cx, robot);
+  // in dart. In-process simulation instead creates a separate skeleton that is
+  // simulated in the main loop
+  Krang::Hardware* krang = NULL;  ///< Interface for the motors and sensors
+  SimHardwareInterface* sim_hw = NULL;  ///< The robot simulated in-process
+  HardwareInterface* hw;  ///< Sensor reads and motor commands of controllers
+  if (in_process_sim) {
+    krang_sim_ach::dart_world::KrangInitPoseParams pose;
+    krang_sim_ach::dart_world::ReadInitPoseParams(
+        "/usr/local/share/krang/balancing/cfg/balancing_params_simulation.cfg",
+        &pose);
+    dart::dynamics::SkeletonPtr plant = dl.parseSkeleton(params.urdfpath);
+    sim_hw = new SimHardwareInterface(robot, plant, pose);
+    hw = sim_hw;
+  } else {
+    int hw_mode = Krang::Hardware::MODE_AMC | Krang::Hardware::MODE_LARM |
+                  Krang::Hardware::MODE_RARM | Krang::Hardware::MODE_TORSO |
+                  Krang::Hardware::MODE_WAIST;
+    krang = new Krang::Hardware((Krang::Hardware::Mode)hw_mode, &daemon_cx,
+                                robot);
+    hw = new KrangHardwareInterface(&daemon_cx, krang);
+  }
   //    Akash made the following edits to add filter_imu option
   // bool filter_imu = (params.is_simulation_ ? false : true);
   // krang = new Krang::Hardware((Krang::Hardware::Mode)hw_mode, &daemon_cx,
@@ -179,13 +231,21 @@ int main(int argc, char* argv[]) {
   pthread_t kbhit_thread;
   pthread_create(&kbhit_thread, NULL, &KbHit, &kb_shared);
 
-  // Constructors for other objects being used in the main loop
-  Joystick joystick;
-  ArmControl arm_control(&daemon_cx, krang, params);
+  // Create a thread that reads the joystick so that the main loop never waits
+  // on the joystick channel
+  JoystickShared js_shared(params.joystickTimeoutMs);  ///< latest input
+  pthread_t joystick_thread;
+  pthread_create(&joystick_thread, NULL, &JoystickThread, &js_shared);
+
+  // Constructors for other objects being used in the main loop. The events
+  // set the commands of the upper body here, and upper_body applies them
+  JoystickState joystick;
+  ArmControl arm_control(NULL, params);
+  UpperBodyExecutor upper_body(hw, params, params.controlRate);
   TorsoState torso_state;
   torso_state.mode = TorsoState::kStop;
   Somatic__WaistMode waist_mode;
-  BalanceControl balance_control(krang, robot, params);
+  BalanceControl balance_control(hw, robot, params, &beta);
   for (int i = 0; i < robot->getNumBodyNodes(); i++) {
     dart::dynamics::BodyNodePtr body = robot->getBodyNode(i);
     std::cout << body->getName() << ": " << body->getMass() << " ";
@@ -200,20 +260,84 @@ int main(int argc, char* argv[]) {
   size_t debug_iter = 0;
   double time = 0.0;
 
+  // Runs the main loop at the configured rate
+  LoopTimer loop_timer(params.controlRate);
+
+  // Latency histograms of the stages of the main loop. Dumped on SIGUSR1
+  // (e.g. pkill -USR1 01-balancing) and on exit
+  TickProfiler profiler(kLoopStageNames, kNumLoopStages);
+  struct sigaction usr1_action;
+  memset(&usr1_action, 0, sizeof(usr1_action));
+  usr1_action.sa_handler = &RequestLatencyDump;
+  sigaction(SIGUSR1, &usr1_action, NULL);
+
+  // Prints the state of the loop from a low-priority thread
+  Logger logger(256);
+  logger.Start();
+
+  // Reloads the gains and thresholds when the cfg file is edited
+  ConfigWatcher config_watcher(config_file, params, balance_control.hack_A(),
+                               balance_control.hack_B());
+  if (params.reloadConfig) config_watcher.Start();
+  ControlTuning tuning;
+
+  // Keeps every iteration of the loop in a memory-mapped ring file
+  FlightRecorder flight_recorder;
+  if (strlen(params.flightRecorderPath) != 0) {
+    flight_recorder.Open(params.flightRecorderPath,
+                         params.flightRecorderCapacity);
+  }
+  uint64_t tick = 0;
+
+  // Heap calls made between the start of an iteration and the wheel command,
+  // counted if built with -Dbalancing_ALLOC_GUARD=COUNT
+  unsigned long num_heap_calls = 0;
+  uint64_t num_heap_ticks = 0;
+
   // Send a message to event logger; set the event code and the priority
   somatic_d_event(&daemon_cx, SOMATIC__EVENT__PRIORITIES__NOTICE,
                   SOMATIC__EVENT__CODES__PROC_RUNNING, NULL, NULL);
 
+  // The upper body runs on its own thread at a fraction of the loop rate,
+  // unless the loop runs freely or steps the simulation itself
+  if (!in_process_sim) upper_body.Start();
+
+  // All other threads exist by now, so only the main loop gets the real-time
+  // priority and the control cpus
+  rt_ready = SetupRtControlThread(params) && rt_ready;
+  if (!rt_ready)
+    std::cout << "[ERR ] rt: setup incomplete, see above" << std::endl;
+
+  loop_timer.Start();
   while (!somatic_sig_received) {
     bool debug = (debug_iter++ % 20 == 0);
 
-    // Read time, state and joystick inputs
-    time +=
-        (params.is_simulation_ ? params.sim_dt_
-                               : balance_control.ElapsedTimeSinceLastCall());
+    // Wait for the start of the next control period. If the previous iteration
+    // overran, more than one period has elapsed since the last one
+    int periods = loop_timer.Wait();
+    profiler.BeginTick();
+
+    // Controller state as the previous iteration left it, to tell whether the
+    // reload or the events below change it
+    ControlEventState prev_event_state;
+    balance_control.GetEventState(&prev_event_state);
+
+    // Gains and thresholds of a reloaded cfg file take effect here, between
+    // two iterations
+    if (config_watcher.NewTuning(&tuning)) balance_control.SetTuning(tuning);
+    AllocGuardArm();
+
+    // Read time, state and joystick inputs. With a fixed loop rate the time
+    // step is a whole number of periods instead of the measured wall time
+    if (params.is_simulation_)
+      time += params.sim_dt_;
+    else if (loop_timer.enabled())
+      time += balance_control.SetTimeStep(periods * loop_timer.period());
+    else
+      time += balance_control.ElapsedTimeSinceLastCall();
     balance_control.UpdateState();
-    bool joystick_msg_received = false;
-    while (!joystick_msg_received) joystick_msg_received = joystick.Update();
+    profiler.EndStage(kUpdateState);
+    ReadJoystickState(js_shared, &joystick, &logger);
 
     // Decide control modes and generate control events based on keyb/joys input
     if (Events(kb_shared, joystick, &start, &balance_control, &waist_mode,
@@ -221,35 +345,77 @@ int main(int argc, char* argv[]) {
       // kill program if kill event was triggered
       break;
     }
+    profiler.EndStage(kEvents);
+
+    // Inputs of the controller in this iteration, for offline replay
+    ControlEventState event_state;
+    balance_control.GetEventState(&event_state);
+    bool events_changed = !SameEventState(prev_event_state, event_state);
 
     // Balancing Control
     double control_input[2];
     balance_control.BalancingController(&control_input[0]);
-    if (start) {
-      somatic_motor_cmd(&daemon_cx, krang->amc,
-                        SOMATIC__MOTOR_PARAM__MOTOR_CURRENT, control_input, 2,
-                        NULL);
+    profiler.EndStage(kBalancingController);
+    unsigned long heap_calls = AllocGuardDisarm();
+    if (heap_calls > 0) {
+      num_heap_calls += heap_calls;
+      num_heap_ticks++;
+    }
+    if (start) hw->SetWheelCurrents(control_input);
+
+    // Record the iteration. Only plain stores into the mapped file
+    if (flight_recorder.is_open()) {
+      FlightRecord* record = flight_recorder.NextRecord();
+      record->tick = tick;
+      record->time = time;
+      record->started = (start ? 1 : 0);
+      record->finger_mode = joystick.fingerMode;
+      record->left_mode = joystick.leftMode;
+      record->right_mode = joystick.rightMode;
+      record->thumb_value[0] = joystick.thumbValue[Joystick::LEFT];
+      record->thumb_value[1] = joystick.thumbValue[Joystick::RIGHT];
+      balance_control.Snapshot(&record->control);
+      balance_control.GetSensorSample(&record->sensors);
+      record->events = event_state;
+      record->events_changed = (events_changed ? 1 : 0);
+      balance_control.GetTuning(&record->tuning);
+      flight_recorder.Commit();
     }
+    tick++;
+    profiler.EndStage(kWheelCommand);
 
-    // Control the rest of the body
-    arm_control.ControlArms();
-    ControlWaist(waist_mode, krang);
-    ControlTorso(daemon_cx, torso_state, krang);
+    // Control the rest of the body, here if it has no thread of its own
+    upper_body.Publish(arm_control, waist_mode, torso_state);
+    if (!upper_body.running() && tick % upper_body.divider() == 0)
+      upper_body.Tick();
+    profiler.EndStage(kUpperBody);
 
     // If in simulation world, make the simulation time step forward
-    if (params.is_simulation_) {
+    if (in_process_sim) {
+      sim_hw->Step(params.sim_dt_);
+    } else if (params.is_simulation_) {
       bool success = world_interface->Step();
       if (!success) break;
     }
+    profiler.EndStage(kSimStep);
+    profiler.EndTick();
 
-    // Print the mode
+    // Have the logger thread dump the latency histograms if asked to. If it
+    // is still printing the previous dump, try again in the next iteration
+    if (latency_dump_requested && logger.DumpProfile(profiler))
+      latency_dump_requested = 0;
+
+    // Hand the state over to the logger thread to be printed
     if (debug) {
-      std::cout << "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv\n" << std::endl;
-      std::cout << "Interface: "
-                << (params.is_simulation_ ? "simulation" : "hardware");
-      balance_control.Print();
-      std::cout << "time: " << time << std::endl;
-      if (start) std::cout << "Started..." << std::endl;
+      LogRecord record;
+      record.time = time;
+      record.is_simulation = (params.is_simulation_ ? 1 : 0);
+      record.started = (start ? 1 : 0);
+      record.loop_timer_enabled = (loop_timer.enabled() ? 1 : 0);
+      record.num_overruns = loop_timer.num_overruns();
+      record.num_missed_deadlines = loop_timer.num_missed_deadlines();
+      balance_control.Snapshot(&record.control);
+      logger.Log(record);
     }
   }
 
@@ -257,9 +423,24 @@ int main(int argc, char* argv[]) {
   somatic_d_event(&daemon_cx, SOMATIC__EVENT__PRIORITIES__NOTICE,
                   SOMATIC__EVENT__CODES__PROC_STOPPING, NULL, NULL);
 
+  logger.Stop();
+  upper_body.Stop();
+  config_watcher.Stop();
+  if (params.reloadConfig) {
+    std::cout << "[INFO] config reloads: " << config_watcher.num_reloads()
+              << ", rejected: " << config_watcher.num_rejected() << std::endl;
+  }
+  loop_timer.PrintStats();
+  profiler.Print();
+  if (AllocGuardEnabled()) {
+    std::cout << "[INFO] heap calls before the wheel command: "
+              << num_heap_calls << " in " << num_heap_ticks << " of " << tick
+              << " iterations" << std::endl;
+  }
   std::cout << "destroying" << std::endl;
-  delete krang;
-  if (params.is_simulation_) {
+  delete hw;
+  if (krang != NULL) delete krang;
+  if (params.is_simulation_ && !in_process_sim) {
     delete world_interface;
     delete interface_context;
   }
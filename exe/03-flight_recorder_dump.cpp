@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file 03-flight_recorder_dump.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Prints the records of a flight recording as comma separated values
+ */
+
+#include <stdlib.h>  // atol()
+
+#include <iostream>  // std::cout, std::endl
+#include <vector>    // std::vector
+
+#include "balancing/control.h"          // BalanceControl
+#include "balancing/flight_recorder.h"  // ReadFlightRecording(), FlightRecord
+
+/* ************************************************************************* */
+/// Usage: 03-flight_recorder_dump <recording> [number of latest records]
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: " << argv[0]
+              << " <recording> [number of latest records]" << std::endl;
+    return 1;
+  }
+
+  std::vector<FlightRecord> records;
+  if (!ReadFlightRecording(argv[1], &records)) return 1;
+  size_t first = 0;
+  if (argc > 2 && (size_t)atol(argv[2]) < records.size())
+    first = records.size() - atol(argv[2]);
+
+  std::cout << "tick,time,started,mode,sample_time,dt,dt_filtered,dt_jitter,"
+            << "th,dth,x,dx,psi,dpsi,"
+            << "ref_th,ref_dth,ref_x,ref_dx,ref_psi,ref_dpsi,"
+            << "err_th,err_dth,err_x,err_dx,err_psi,err_dpsi,"
+            << "k_th,k_dth,k_x,k_dx,k_psi,k_dpsi,com_x,com_y,com_z,"
+            << "js_forw,js_spin,finger_mode,left_mode,right_mode,"
+            << "thumb_left,thumb_right,imu,waist,dynamic_lqr,lqr_gain_age,"
+            << "lqr_cache_hits,lqr_cache_misses,lqr_linearizations,lqr_reuses,"
+            << "lqr_table_misses,current_left,current_right,events_changed" << std::endl;
+  std::cout.precision(10);
+  for (size_t i = first; i < records.size(); i++) {
+    const FlightRecord& r = records[i];
+    const ControlSnapshot& c = r.control;
+    std::cout << r.tick << "," << r.time << "," << r.started << ","
+              << BalanceControl::MODE_STRINGS[c.balance_mode] << ","
+              << r.sensors.time << "," << c.dt << "," << c.dt_filtered << ","
+              << c.dt_jitter;
+    for (int j = 0; j < 6; j++) std::cout << "," << c.state[j];
+    for (int j = 0; j < 6; j++) std::cout << "," << c.ref_state[j];
+    for (int j = 0; j < 6; j++) std::cout << "," << c.error[j];
+    for (int j = 0; j < 6; j++) std::cout << "," << c.pd_gains[j];
+    for (int j = 0; j < 3; j++) std::cout << "," << c.com[j];
+    std::cout << "," << c.joystick_forw << "," << c.joystick_spin << ","
+              << r.finger_mode << "," << r.left_mode << "," << r.right_mode
+              << "," << r.thumb_value[0] << "," << r.thumb_value[1] << ","
+              << c.imu << "," << c.waist_angle << "," << c.dynamic_lqr << ","
+              << c.lqr_gain_age << "," << c.lqr_cache_hits << ","
+              << c.lqr_cache_misses << "," << c.lqr_linearizations << ","
+              << c.lqr_reuses << "," << c.lqr_table_misses << ","
+              << c.control_input[0] << "," << c.control_input[1] << ","
+              << r.events_changed << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file 04-replay.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Replays a flight recording through the balancing controller offline
+ * and checks that the same wheel currents are produced
+ */
+
+#include <stdint.h>  // uint64_t
+#include <stdlib.h>  // atoi()
+#include <string.h>  // memcmp(), memcpy(), strcmp(), strcpy()
+
+#include <cmath>     // fabs()
+#include <iostream>  // std::cout, std::endl
+#include <vector>    // std::vector
+
+#include <amino/time.h>  // aa_tm: _now(), _timespec2sec(), _sub()
+#include <dart/dart.hpp>             // dart::dynamics::SkeletonPtr
+#include <dart/utils/urdf/urdf.hpp>  // dart::utils::DartLoader
+
+#include "balancing/alloc_guard.h"  // AllocGuardArm(), AllocGuardDisarm()
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams()
+#include "balancing/control.h"           // BalanceControl, ControlTuning
+#include "balancing/flight_recorder.h"  // ReadFlightRecording(), FlightRecord
+
+/* ************************************************************************* */
+// FNV-1a hash of the bytes of the wheel currents. Equal checksums across
+// repetitions mean the replay is bit-for-bit reproducible
+uint64_t HashCurrents(uint64_t hash, const double* control_input) {
+  unsigned char bytes[2 * sizeof(double)];
+  memcpy(bytes, control_input, sizeof(bytes));
+  for (size_t i = 0; i < sizeof(bytes); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/* ************************************************************************* */
+/// Usage: 04-replay <recording> <s|h> [repetitions]
+/// The second argument selects the config file the recording was made with
+int main(int argc, char* argv[]) {
+  if (argc < 3 || (argv[2][0] != 's' && argv[2][0] != 'h')) {
+    std::cout << "Usage: " << argv[0] << " <recording> <s|h> [repetitions]"
+              << std::endl;
+    return 1;
+  }
+  int repetitions = (argc > 3 ? atoi(argv[3]) : 1);
+  if (repetitions < 1) repetitions = 1;
+
+  std::vector<FlightRecord> records;
+  if (!ReadFlightRecording(argv[1], &records)) return 1;
+  if (records.empty()) {
+    std::cout << "Recording is empty" << std::endl;
+    return 1;
+  }
+
+  // Read config parameters of the run that was recorded
+  BalancingConfig params;
+  params.is_simulation_ = (argv[2][0] == 's');
+  ReadConfigParams(
+      (params.is_simulation_
+           ? "/usr/local/share/krang/balancing/cfg/"
+             "balancing_params_simulation.cfg"
+           : "/usr/local/share/krang/balancing/cfg/balancing_params.cfg"),
+      &params);
+  params.sim_dt_ = records[0].control.dt;
+
+  // Gains from the background solver depend on thread timing and cannot be
+  // reproduced, so they are solved in the loop instead
+  if (strcmp(params.lqrGainSource, "background") == 0)
+    strcpy(params.lqrGainSource, "online");
+
+  // Reused linearizations, cached gains and the warm start of the solver make
+  // the gains depend on iterations before the first record, which the ring
+  // may no longer hold. Without them the gains of an iteration only depend on
+  // its own pose, so any stretch of the run replays the same way
+  params.lqrRelinearizeTolerance = -1.0;
+  params.lqrGainCacheSize = 0;
+  params.lqrWarmStart = false;
+
+  // Load the robot
+  dart::utils::DartLoader dl;
+  dart::dynamics::SkeletonPtr robot;  ///< the robot representation in dart
+  robot = dl.parseSkeleton(params.urdfpath);
+  assert((robot != NULL) && "Could not find the robot urdf");
+  if (records[0].sensors.num_dofs != (int)robot->getNumDofs()) {
+    std::cout << "Recording has " << records[0].sensors.num_dofs
+              << " dofs but the robot has " << robot->getNumDofs() << std::endl;
+    return 1;
+  }
+
+  uint64_t first_checksum = 0;
+  size_t mismatches = 0;
+  double max_difference = 0.0;
+  double replay_time = 0.0;
+  unsigned long num_heap_calls = 0;
+  for (int rep = 0; rep < repetitions; rep++) {
+    // Start every repetition from the same pose and a fresh controller
+    for (int i = 0; i < records[0].sensors.num_dofs; i++)
+      robot->setPosition(i, records[0].sensors.q[i]);
+    BalanceControl balance_control(NULL, robot, params);
+
+    uint64_t checksum = 14695981039346656037ULL;
+    struct timespec t_start = aa_tm_now();
+    for (size_t i = 0; i < records.size(); i++) {
+      const FlightRecord& r = records[i];
+      balance_control.SetTimeStep(r.control.dt);
+      AllocGuardArm();
+      balance_control.UpdateState(r.sensors);
+      // Only the events and reloads of the recorded run set the controller
+      // state. In between, the controller evolves it as it did on the robot.
+      // The first record also sets the state the replay starts from. The
+      // gains and thresholds of all modes go first, since the event state
+      // holds those of the current mode as the events left them
+      if (i == 0 || memcmp(&r.tuning, &records[i - 1].tuning,
+                           sizeof(ControlTuning)) != 0)
+        balance_control.SetTuning(r.tuning);
+      if (i == 0 || r.events_changed)
+        balance_control.SetEventState(r.events);
+      double control_input[2];
+      balance_control.BalancingController(&control_input[0]);
+      num_heap_calls += AllocGuardDisarm();
+      checksum = HashCurrents(checksum, control_input);
+
+      if (rep == 0) {
+        for (int j = 0; j < 2; j++) {
+          double difference =
+              fabs(control_input[j] - r.control.control_input[j]);
+          if (difference > max_difference) max_difference = difference;
+        }
+        if (control_input[0] != r.control.control_input[0] ||
+            control_input[1] != r.control.control_input[1]) {
+          if (mismatches == 0)
+            std::cout << "First mismatch at tick " << r.tick << std::endl;
+          mismatches++;
+        }
+      }
+    }
+    replay_time += aa_tm_timespec2sec(aa_tm_sub(aa_tm_now(), t_start));
+
+    if (rep == 0) {
+      first_checksum = checksum;
+    } else if (checksum != first_checksum) {
+      std::cout << "Repetition " << rep << " differs from the first one"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "Replayed " << records.size() << " ticks (" << records[0].tick
+            << " to " << records.back().tick << ") " << repetitions
+            << " time(s)" << std::endl;
+  std::cout << "Ticks not matching the recording: " << mismatches
+            << ", max current difference: " << max_difference << std::endl;
+  std::cout << std::hex << "Checksum: " << first_checksum << std::dec
+            << std::endl;
+  if (AllocGuardEnabled())
+    std::cout << "Heap calls in the controller: " << num_heap_calls
+              << std::endl;
+  std::cout << "Ticks per second: "
+            << (records.size() * repetitions) / replay_time << std::endl;
+  return (mismatches == 0 ? 0 : 2);
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file 05-monte_carlo.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Runs many simulated stand-up and balance trials of perturbed robots
+ * in parallel to evaluate the robustness of gain sets
+ */
+
+#include <assert.h>   // assert()
+#include <math.h>     // fabs()
+#include <pthread.h>  // pthread_mutex_t
+#include <stdlib.h>   // atoi(), atof()
+#include <string.h>   // memset()
+
+#include <algorithm>  // std::sort(), std::max()
+#include <iostream>   // std::cout, std::endl
+#include <random>     // std::mt19937, std::normal_distribution
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+#include <amino/time.h>  // aa_tm: _now(), _timespec2sec(), _sub()
+#include <dart/dart.hpp>             // dart::dynamics::SkeletonPtr
+#include <dart/utils/urdf/urdf.hpp>  // dart::utils::DartLoader
+#include <krang-sim-ach/dart_world.h>  // KrangInitPoseParams, ReadInitPoseParams()
+#include <krang-utils/file_ops.hpp>    // readInputFileAsMatrix()
+
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams()
+#include "balancing/control.h"           // BalanceControl, ApplyComParameters()
+#include "balancing/sensors.h"           // SensorSample
+#include "balancing/sim_hardware_interface.h"  // SimHardwareInterface
+#include "balancing/thread_pool.h"             // ThreadPool
+
+/* ************************************************************************* */
+// Perturbations of each trial (standard deviations)
+const double kMassStdDev = 0.05;       // relative error of each body mass
+const double kComStdDev = 0.01;        // error of each body com (m)
+const double kImuStdDev = 0.002;       // imu angle noise (rad)
+const double kImuSpeedStdDev = 0.01;   // imu speed noise (rad/s)
+const double kBaseInitStdDev = 0.02;   // initial q_base_init error (rad)
+const double kWaistInitStdDev = 0.03;  // initial q_waist_init error (rad)
+
+// Scenario: sit for kStandTime seconds, then try to stand up and balance
+const double kStandTime = 0.5;  // (s)
+
+// CoM angle beyond which a balancing robot is considered to have fallen
+const double kFallAngle = 0.5;  // (rad)
+
+const char kSimulationCfg[] =
+    "/usr/local/share/krang/balancing/cfg/balancing_params_simulation.cfg";
+
+/* ************************************************************************* */
+// In-process plant whose imu readings carry gaussian noise
+class NoisySimHardwareInterface : public SimHardwareInterface {
+ public:
+  NoisySimHardwareInterface(
+      dart::dynamics::SkeletonPtr robot, dart::dynamics::SkeletonPtr plant,
+      const krang_sim_ach::dart_world::KrangInitPoseParams& pose,
+      std::mt19937* rng)
+      : SimHardwareInterface(robot, plant, pose), rng_(rng) {}
+
+  void ReadSensors(double dt, SensorSample* sample) {
+    SimHardwareInterface::ReadSensors(dt, sample);
+    sample->imu += kImuStdDev * normal_(*rng_);
+    sample->imu_speed += kImuSpeedStdDev * normal_(*rng_);
+  }
+
+ private:
+  std::mt19937* rng_;
+  std::normal_distribution<double> normal_;
+};
+
+/* ************************************************************************* */
+// What is shared by the trials of one gain set. Read-only while they run
+struct TrialSetup {
+  BalancingConfig params;
+  dart::dynamics::SkeletonPtr nominal;  // urdf with the nominal beta applied
+  krang_sim_ach::dart_world::KrangInitPoseParams pose;
+  double duration;                      // (s)
+  unsigned int seed;
+  pthread_mutex_t* clone_mutex;         // serializes cloning of nominal
+};
+
+struct TrialResult {
+  bool stood_up;         // reached Bal Lo mode
+  bool fell;             // lost balance after standing up
+  double stand_up_time;  // from the stand event to Bal Lo mode (s)
+  double peak_current;   // largest wheel current command (A)
+};
+
+/* ************************************************************************* */
+// One trial: a perturbed plant and a fresh controller that only knows the
+// nominal model. Seeded by the trial index so that results do not depend on
+// the scheduling
+void RunTrial(const TrialSetup& setup, int index, TrialResult* result) {
+  std::mt19937 rng(setup.seed + index);
+  std::normal_distribution<double> normal;
+
+  dart::dynamics::SkeletonPtr robot, plant;
+  pthread_mutex_lock(setup.clone_mutex);
+  robot = setup.nominal->clone();
+  plant = setup.nominal->clone();
+  pthread_mutex_unlock(setup.clone_mutex);
+
+  // Perturb the CoM parameters of the plant
+  for (int i = 0; i < plant->getNumBodyNodes(); i++) {
+    dart::dynamics::BodyNodePtr body = plant->getBodyNode(i);
+    body->setMass(body->getMass() * (1.0 + kMassStdDev * normal(rng)));
+    Eigen::Vector3d com = body->getLocalCOM();
+    for (int j = 0; j < 3; j++) com(j) += kComStdDev * normal(rng);
+    body->setLocalCOM(com);
+  }
+  krang_sim_ach::dart_world::KrangInitPoseParams pose = setup.pose;
+  pose.q_base_init += kBaseInitStdDev * normal(rng);
+  pose.q_waist_init += kWaistInitStdDev * normal(rng);
+
+  BalancingConfig params = setup.params;
+  NoisySimHardwareInterface hw(robot, plant, pose, &rng);
+  BalanceControl balance_control(&hw, robot, params);
+
+  memset(result, 0, sizeof(*result));
+  const double dt = params.sim_dt_;
+  const int num_steps = setup.duration / dt;
+  const int stand_step = kStandTime / dt;
+  ControlSnapshot snapshot;
+  for (int i = 0; i < num_steps; i++) {
+    balance_control.SetTimeStep(dt);
+    balance_control.UpdateState();
+    if (i == stand_step) balance_control.StandSitEvent();
+
+    double control_input[2];
+    balance_control.BalancingController(&control_input[0]);
+    hw.SetWheelCurrents(control_input);
+    result->peak_current =
+        std::max(result->peak_current,
+                 std::max(fabs(control_input[0]), fabs(control_input[1])));
+
+    balance_control.Snapshot(&snapshot);
+    if (!result->stood_up && snapshot.balance_mode == BalanceControl::BAL_LO) {
+      result->stood_up = true;
+      result->stand_up_time = (i - stand_step) * dt;
+    }
+    if (result->stood_up && fabs(snapshot.state[0]) > kFallAngle) {
+      result->fell = true;
+      break;
+    }
+
+    hw.Step(dt);
+  }
+}
+
+/* ************************************************************************* */
+void PrintSummary(const char* name, const std::vector<TrialResult>& results) {
+  int num_stood_up = 0, num_fell = 0;
+  double peak_current = 0.0, mean_peak_current = 0.0;
+  std::vector<double> stand_up_times;
+  for (size_t i = 0; i < results.size(); i++) {
+    if (results[i].stood_up) {
+      num_stood_up++;
+      stand_up_times.push_back(results[i].stand_up_time);
+    }
+    if (results[i].fell) num_fell++;
+    peak_current = std::max(peak_current, results[i].peak_current);
+    mean_peak_current += results[i].peak_current / results.size();
+  }
+  std::sort(stand_up_times.begin(), stand_up_times.end());
+
+  std::cout << name << std::endl;
+  std::cout << "  trials: " << results.size() << ", stood up: "
+            << 100.0 * num_stood_up / results.size() << "%, fell: "
+            << 100.0 * num_fell / results.size() << "%" << std::endl;
+  if (!stand_up_times.empty()) {
+    double mean = 0.0;
+    for (size_t i = 0; i < stand_up_times.size(); i++)
+      mean += stand_up_times[i] / stand_up_times.size();
+    std::cout << "  stand-up time (s): mean " << mean << ", median "
+              << stand_up_times[stand_up_times.size() / 2] << ", max "
+              << stand_up_times.back() << std::endl;
+  }
+  std::cout << "  peak current (A): mean " << mean_peak_current << ", max "
+            << peak_current << std::endl;
+}
+
+/* ************************************************************************* */
+/// Usage: 05-monte_carlo <trials per gain set> [seconds per trial]
+///                       [gain cfg file ...]
+/// Without cfg files the gains in balancing_params_simulation.cfg are used.
+/// The initial pose is always read from balancing_params_simulation.cfg
+int main(int argc, char* argv[]) {
+  if (argc < 2 || atoi(argv[1]) <= 0) {
+    std::cout << "Usage: " << argv[0]
+              << " <trials per gain set> [seconds per trial]"
+              << " [gain cfg file ...]" << std::endl;
+    return 1;
+  }
+  int num_trials = atoi(argv[1]);
+  double duration = (argc > 2 ? atof(argv[2]) : 10.0);
+  std::vector<std::string> cfg_files;
+  for (int i = 3; i < argc; i++) cfg_files.push_back(argv[i]);
+  if (cfg_files.empty()) cfg_files.push_back(kSimulationCfg);
+
+  // Gain sets
+  std::vector<TrialSetup> setups(cfg_files.size());
+  pthread_mutex_t clone_mutex;
+  pthread_mutex_init(&clone_mutex, NULL);
+  for (size_t s = 0; s < setups.size(); s++) {
+    TrialSetup& setup = setups[s];
+    setup.params.is_simulation_ = true;
+    ReadConfigParams(cfg_files[s].c_str(), &setup.params);
+    setup.params.sim_dt_ = ReadConfigTimeStep(
+        "/usr/local/share/krang-sim-ach/cfg/dart_params.cfg");
+    if (setup.params.sim_dt_ <= 0.0) {
+      std::cout << "Error reading time step" << std::endl;
+      return 1;
+    }
+    krang_sim_ach::dart_world::ReadInitPoseParams(kSimulationCfg, &setup.pose);
+    setup.duration = duration;
+    setup.seed = 1;  // same for all gain sets, which then face the same
+                     // perturbations
+    setup.clone_mutex = &clone_mutex;
+
+    // The nominal model carries the CoM parameters, so that the controllers
+    // do not read them again
+    dart::utils::DartLoader dl;
+    setup.nominal = dl.parseSkeleton(setup.params.urdfpath);
+    assert((setup.nominal != NULL) && "Could not find the robot urdf");
+    if (strlen(setup.params.comParametersPath) != 0) {
+      Eigen::MatrixXd beta =
+          readInputFileAsMatrix(setup.params.comParametersPath);
+      ApplyComParameters(beta, 4, setup.nominal);
+      setup.params.comParametersPath[0] = '\0';
+    }
+  }
+
+  // The controllers print on mode changes; keep the output to the summary
+  std::vector<std::vector<TrialResult> > results(setups.size());
+  for (size_t s = 0; s < setups.size(); s++) results[s].resize(num_trials);
+  ThreadPool pool(0);
+  std::cout << "Running " << num_trials * setups.size() << " trials on "
+            << pool.num_threads() << " threads" << std::endl;
+  std::cout.setstate(std::ios::failbit);
+  struct timespec t_start = aa_tm_now();
+  for (size_t s = 0; s < setups.size(); s++) {
+    for (int i = 0; i < num_trials; i++) {
+      const TrialSetup* setup = &setups[s];
+      TrialResult* result = &results[s][i];
+      pool.Submit([setup, i, result]() { RunTrial(*setup, i, result); });
+    }
+  }
+  pool.Wait();
+  double elapsed = aa_tm_timespec2sec(aa_tm_sub(aa_tm_now(), t_start));
+  std::cout.clear();
+
+  for (size_t s = 0; s < setups.size(); s++)
+    PrintSummary(cfg_files[s].c_str(), results[s]);
+  std::cout << "Elapsed: " << elapsed << " s ("
+            << 60.0 * num_trials * setups.size() / elapsed
+            << " trials per minute, " << pool.num_steals() << " steals)"
+            << std::endl;
+  pthread_mutex_destroy(&clone_mutex);
+  return 0;
+}
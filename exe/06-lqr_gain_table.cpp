@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file 06-lqr_gain_table.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Precomputes the dynamic LQR gains over a grid of waist and torso
+ * angles for the "table" lqrGainSource
+ */
+
+#include <assert.h>  // assert()
+#include <stdlib.h>  // atoi()
+#include <string.h>  // memset(), strlen()
+
+#include <iostream>  // std::cout, std::endl
+
+#include <Eigen/Eigen>                // Eigen::MatrixXd
+#include <dart/dart.hpp>              // dart::dynamics::SkeletonPtr
+#include <dart/utils/urdf/urdf.hpp>   // dart::utils::DartLoader
+#include <krang-utils/file_ops.hpp>   // readInputFileAsMatrix()
+
+#include "balancing/arms.h"              // ArmControl::presetArmConfs
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams()
+#include "balancing/control.h"           // ApplyComParameters()
+#include "balancing/lqr_gains.h"  // ComputeLqrGains(), LqrGainTable,
+                                  // HashComParameters()
+#include "balancing/riccati.h"    // RiccatiSolver
+#include "balancing/sensors.h"    // kWaistDof, kTorsoDof, kArmDof
+
+/* ************************************************************************* */
+/// Usage: 06-lqr_gain_table <s|h> <output> [waist points] [torso points]
+///                          [arm preset]
+/// The lqr costs, urdf and CoM parameters are read from the cfg file of the
+/// chosen mode. The angles are swept over the joint limits in the urdf and
+/// the arms are held in the given preset of ArmControl (default: 1)
+int main(int argc, char* argv[]) {
+  if (argc < 3 || (argv[1][0] != 's' && argv[1][0] != 'h')) {
+    std::cout << "Usage: " << argv[0]
+              << " <s|h> <output> [waist points] [torso points] [arm preset]"
+              << std::endl;
+    return 1;
+  }
+  int num_waist = (argc > 3 ? atoi(argv[3]) : 31);
+  int num_torso = (argc > 4 ? atoi(argv[4]) : 21);
+  int arm_preset = (argc > 5 ? atoi(argv[5]) : 1);
+  if (num_waist < 2 || num_torso < 2 || arm_preset < 0 || arm_preset > 3) {
+    std::cout << "Need at least 2 points per angle and a preset in 0-3"
+              << std::endl;
+    return 1;
+  }
+
+  // Read config parameters of the chosen mode
+  BalancingConfig params;
+  params.is_simulation_ = (argv[1][0] == 's');
+  ReadConfigParams(
+      (params.is_simulation_
+           ? "/usr/local/share/krang/balancing/cfg/"
+             "balancing_params_simulation.cfg"
+           : "/usr/local/share/krang/balancing/cfg/balancing_params.cfg"),
+      &params);
+
+  // Load the robot with the same CoM parameters as the controller
+  dart::utils::DartLoader dl;
+  dart::dynamics::SkeletonPtr robot = dl.parseSkeleton(params.urdfpath);
+  assert((robot != NULL) && "Could not find the robot urdf");
+  Eigen::MatrixXd beta;
+  if (strlen(params.comParametersPath) != 0) {
+    beta = readInputFileAsMatrix(params.comParametersPath);
+    ApplyComParameters(beta, 4, robot);
+  }
+
+  // Grid and arm pose
+  LqrGainTableHeader header;
+  memset(&header, 0, sizeof(header));
+  header.is_simulation = (params.is_simulation_ ? 1 : 0);
+  header.num_waist = num_waist;
+  header.num_torso = num_torso;
+  header.waist_min = robot->getDof(kWaistDof)->getPositionLowerLimit();
+  header.waist_max = robot->getDof(kWaistDof)->getPositionUpperLimit();
+  header.torso_min = robot->getDof(kTorsoDof)->getPositionLowerLimit();
+  header.torso_max = robot->getDof(kTorsoDof)->getPositionUpperLimit();
+  for (int i = 0; i < 4; i++) header.lqr_q[i] = params.lqrQ(i, i);
+  header.lqr_r = params.lqrR(0, 0);
+  header.com_parameters_hash = HashComParameters(beta);
+  header.arm_preset = arm_preset;
+  for (int side = 0; side < 2; side++) {
+    for (int i = 0; i < 7; i++) {
+      header.arm_pose[7 * side + i] =
+          ArmControl::presetArmConfs[2 * arm_preset + side][i];
+      robot->setPosition(kArmDof[side] + i, header.arm_pose[7 * side + i]);
+    }
+  }
+  std::cout << "waist: " << header.waist_min << " to " << header.waist_max
+            << ", torso: " << header.torso_min << " to " << header.torso_max
+            << std::endl;
+
+  // Sweep. Only the waist and torso change between grid points; the base
+  // stays as loaded from the urdf
+  LqrGainTable table;
+  table.Create(header);
+  // Neighbouring grid points are close enough to warm-start the solver
+  RiccatiSolver<4, 1> riccati;
+  Eigen::Matrix<double, 4, 1> gains;
+  for (int i = 0; i < num_waist; i++) {
+    robot->setPosition(kWaistDof, table.waist(i));
+    for (int j = 0; j < num_torso; j++) {
+      robot->setPosition(kTorsoDof, table.torso(j));
+      ComputeLqrGains(robot, params.is_simulation_, params.lqrQ, params.lqrR,
+                      &gains, &riccati);
+      table.Set(i, j, gains);
+    }
+    std::cout << "\r" << i + 1 << "/" << num_waist << std::flush;
+  }
+  std::cout << std::endl;
+
+  if (!table.Save(argv[2])) return 1;
+  std::cout << "Wrote " << num_waist * num_torso << " gains to " << argv[2]
+            << std::endl;
+  return 0;
+}
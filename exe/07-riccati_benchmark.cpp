@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file 07-riccati_benchmark.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Compares the cost and result of the warm-started RiccatiSolver with
+ * lqr() of krang-utils over a sequence of poses as seen by the control loop
+ */
+
+#include <assert.h>  // assert()
+#include <stdlib.h>  // atoi(), atof()
+#include <string.h>  // strlen()
+
+#include <algorithm>  // std::max()
+#include <iostream>   // std::cout, std::endl
+#include <vector>     // std::vector
+
+#include <amino/time.h>  // aa_tm: _now(), _timespec2sec(), _sub()
+#include <Eigen/Eigen>               // Eigen::MatrixXd, Eigen::VectorXd
+#include <dart/dart.hpp>             // dart::dynamics::SkeletonPtr
+#include <dart/utils/urdf/urdf.hpp>  // dart::utils::DartLoader
+#include <krang-utils/file_ops.hpp>  // readInputFileAsMatrix()
+#include <krang-utils/lqr.hpp>       // lqr()
+
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams()
+#include "balancing/control.h"           // ApplyComParameters()
+#include "balancing/lqr_gains.h"         // LinearizeWip()
+#include "balancing/riccati.h"           // RiccatiSolver
+#include "balancing/sensors.h"           // kWaistDof
+
+typedef Eigen::Matrix<double, 4, 4> Matrix4d;
+typedef Eigen::Matrix<double, 4, 1> Vector4d;
+typedef Eigen::Matrix<double, 1, 4> RowVector4d;
+
+/* ************************************************************************* */
+// Seconds since start
+double SecondsSince(const struct timespec& start) {
+  return aa_tm_timespec2sec(aa_tm_sub(aa_tm_now(), start));
+}
+
+/* ************************************************************************* */
+/// Usage: 07-riccati_benchmark <s|h> [poses] [waist step]
+/// Linearizes the robot at consecutive poses in which the waist moves by the
+/// given step (default: 0.0002 rad, the waist at full speed for one iteration
+/// at 500 Hz), then times lqr() of krang-utils, RiccatiSolver from scratch
+/// and RiccatiSolver warm-started from the previous pose on every pose
+int main(int argc, char* argv[]) {
+  if (argc < 2 || (argv[1][0] != 's' && argv[1][0] != 'h')) {
+    std::cout << "Usage: " << argv[0] << " <s|h> [poses] [waist step]"
+              << std::endl;
+    return 1;
+  }
+  int num_poses = (argc > 2 ? atoi(argv[2]) : 1000);
+  double waist_step = (argc > 3 ? atof(argv[3]) : 0.0002);
+  if (num_poses < 1) {
+    std::cout << "Need at least one pose" << std::endl;
+    return 1;
+  }
+
+  // Read config parameters of the chosen mode
+  BalancingConfig params;
+  params.is_simulation_ = (argv[1][0] == 's');
+  ReadConfigParams(
+      (params.is_simulation_
+           ? "/usr/local/share/krang/balancing/cfg/"
+             "balancing_params_simulation.cfg"
+           : "/usr/local/share/krang/balancing/cfg/balancing_params.cfg"),
+      &params);
+
+  // Load the robot with the same CoM parameters as the controller
+  dart::utils::DartLoader dl;
+  dart::dynamics::SkeletonPtr robot = dl.parseSkeleton(params.urdfpath);
+  assert((robot != NULL) && "Could not find the robot urdf");
+  if (strlen(params.comParametersPath) != 0) {
+    Eigen::MatrixXd beta = readInputFileAsMatrix(params.comParametersPath);
+    ApplyComParameters(beta, 4, robot);
+  }
+
+  // Linearized dynamics at every pose
+  std::vector<Matrix4d> A(num_poses);
+  std::vector<Vector4d> B(num_poses);
+  Eigen::MatrixXd A_pose = Eigen::MatrixXd::Zero(4, 4);
+  Eigen::MatrixXd B_pose = Eigen::MatrixXd::Zero(4, 1);
+  double waist = robot->getDof(kWaistDof)->getPositionLowerLimit();
+  struct timespec t_start = aa_tm_now();
+  for (int i = 0; i < num_poses; i++) {
+    robot->setPosition(kWaistDof, waist + i * waist_step);
+    LinearizeWip(robot, params.is_simulation_, &A_pose, &B_pose);
+    A[i] = A_pose;
+    B[i] = B_pose;
+  }
+  double linearize_time = SecondsSince(t_start);
+
+  // lqr() of krang-utils, the reference
+  std::vector<RowVector4d> K_lqr(num_poses);
+  Eigen::MatrixXd Q = params.lqrQ, R = params.lqrR;
+  Eigen::VectorXd K_pose = Eigen::VectorXd::Zero(4);
+  t_start = aa_tm_now();
+  for (int i = 0; i < num_poses; i++) {
+    A_pose = A[i];
+    B_pose = B[i];
+    lqr(A_pose, B_pose, Q, R, K_pose);
+    K_lqr[i] = K_pose.transpose();
+  }
+  double lqr_time = SecondsSince(t_start);
+
+  // RiccatiSolver from scratch and warm-started
+  const char* kSolverNames[] = {"RiccatiSolver cold", "RiccatiSolver warm"};
+  double solver_time[2], max_difference[2];
+  int iterations[2], failures[2];
+  for (int warm = 0; warm < 2; warm++) {
+    RiccatiSolver<4, 1> solver;
+    std::vector<RowVector4d> K(num_poses);
+    iterations[warm] = failures[warm] = 0;
+    t_start = aa_tm_now();
+    for (int i = 0; i < num_poses; i++) {
+      if (!warm) solver.Reset();
+      if (!solver.Solve(A[i], B[i], params.lqrQ, params.lqrR, &K[i])) {
+        K[i] = K_lqr[i];
+        failures[warm]++;
+      }
+      iterations[warm] += solver.iterations();
+    }
+    solver_time[warm] = SecondsSince(t_start);
+
+    max_difference[warm] = 0.0;
+    for (int i = 0; i < num_poses; i++) {
+      max_difference[warm] =
+          std::max(max_difference[warm],
+                   (K[i] - K_lqr[i]).norm() / K_lqr[i].norm());
+    }
+  }
+
+  std::cout << num_poses << " poses, waist step " << waist_step << " rad"
+            << std::endl;
+  std::cout << "linearization: " << 1e6 * linearize_time / num_poses
+            << " us/pose" << std::endl;
+  std::cout << "lqr(): " << 1e6 * lqr_time / num_poses << " us/pose"
+            << std::endl;
+  for (int warm = 0; warm < 2; warm++) {
+    std::cout << kSolverNames[warm] << ": "
+              << 1e6 * solver_time[warm] / num_poses << " us/pose, "
+              << (double)iterations[warm] / num_poses
+              << " iterations/pose, " << failures[warm]
+              << " failures, max relative difference to lqr(): "
+              << max_difference[warm] << std::endl;
+  }
+  return 0;
+}
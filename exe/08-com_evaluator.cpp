@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file 08-com_evaluator.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Checks the closed-form ComEvaluator against dart on random poses
+ * and compares the cost of the ways the controller can compute the com
+ */
+
+#include <assert.h>  // assert()
+#include <stdlib.h>  // atoi()
+#include <string.h>  // strlen()
+
+#include <algorithm>  // std::max()
+#include <cmath>      // std::isinf()
+#include <iostream>   // std::cout, std::endl
+#include <random>     // std::mt19937, std::uniform_real_distribution
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+#include <amino/time.h>  // aa_tm: _now(), _timespec2sec(), _sub()
+#include <Eigen/Eigen>               // Eigen::MatrixXd, Eigen::Vector3d
+#include <dart/dart.hpp>             // dart::dynamics::SkeletonPtr
+#include <dart/utils/urdf/urdf.hpp>  // dart::utils::DartLoader
+#include <krang-utils/file_ops.hpp>  // readInputFileAsMatrix()
+
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams()
+#include "balancing/com_engine.h"        // ComEngine
+#include "balancing/com_evaluator.h"     // ComEvaluator
+#include "balancing/com_kernel.h"        // ComKernelUsesAvx2()
+#include "balancing/control.h"  // BalanceControl::GetBodyCom(), ApplyComParameters()
+#include "balancing/sensors.h"  // kWaistDof, kTorsoDof
+
+/* ************************************************************************* */
+// Seconds since start
+double SecondsSince(const struct timespec& start) {
+  return aa_tm_timespec2sec(aa_tm_sub(aa_tm_now(), start));
+}
+
+/* ************************************************************************* */
+// Sets the dofs of robot to q
+void SetPositions(dart::dynamics::SkeletonPtr robot, const double* q) {
+  for (size_t i = 0; i < robot->getNumDofs(); i++)
+    robot->setPosition(i, q[i]);
+}
+
+/* ************************************************************************* */
+/// Usage: 08-com_evaluator <s|h> [poses]
+/// Loads the robot with the CoM parameters of the chosen cfg file, checks
+/// ComEvaluator and ComEngine against BalanceControl::GetBodyCom() on random
+/// poses within the joint limits and times all three on them. ComEngine is
+/// timed twice: with every joint moving between poses and with only the base
+/// and waist moving, as in the control loop with the arms still
+int main(int argc, char* argv[]) {
+  if (argc < 2 || (argv[1][0] != 's' && argv[1][0] != 'h')) {
+    std::cout << "Usage: " << argv[0] << " <s|h> [poses]" << std::endl;
+    return 1;
+  }
+  int num_poses = (argc > 2 ? atoi(argv[2]) : 10000);
+  if (num_poses < 1) {
+    std::cout << "Need at least one pose" << std::endl;
+    return 1;
+  }
+
+  // Read config parameters of the chosen mode
+  BalancingConfig params;
+  params.is_simulation_ = (argv[1][0] == 's');
+  ReadConfigParams(
+      (params.is_simulation_
+           ? "/usr/local/share/krang/balancing/cfg/"
+             "balancing_params_simulation.cfg"
+           : "/usr/local/share/krang/balancing/cfg/balancing_params.cfg"),
+      &params);
+
+  // Load the robot with the same CoM parameters as the controller
+  dart::utils::DartLoader dl;
+  dart::dynamics::SkeletonPtr robot = dl.parseSkeleton(params.urdfpath);
+  assert((robot != NULL) && "Could not find the robot urdf");
+  if (strlen(params.comParametersPath) != 0) {
+    Eigen::MatrixXd beta = readInputFileAsMatrix(params.comParametersPath);
+    ApplyComParameters(beta, 4, robot);
+  }
+  std::vector<std::string> wheels{"LWheel", "RWheel"};
+  ComEvaluator evaluator;
+  if (!evaluator.Compile(robot, wheels)) return 1;
+  ComEngine engine(robot, wheels);
+  std::cout << evaluator.num_links() << " links, " << evaluator.mass()
+            << " kg, com kernel: "
+            << (ComKernelUsesAvx2() ? "AVX2" : "scalar") << std::endl;
+
+  // Random poses. Joints without limits and the base orientation are drawn
+  // within +-pi, the base position within +-1 m
+  int num_dofs = robot->getNumDofs();
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<double> poses(num_poses * num_dofs);
+  for (int i = 0; i < num_poses; i++) {
+    for (int j = 0; j < num_dofs; j++) {
+      double lower = robot->getDof(j)->getPositionLowerLimit();
+      double upper = robot->getDof(j)->getPositionUpperLimit();
+      if (j < 6 || std::isinf(lower) || std::isinf(upper)) {
+        lower = (j >= 3 && j < 6 ? -1.0 : -M_PI);
+        upper = -lower;
+      }
+      poses[i * num_dofs + j] = lower + (upper - lower) * unit(generator);
+    }
+  }
+  // The same poses with everything but the base and waist at the first pose
+  std::vector<double> base_poses(poses);
+  for (int i = 1; i < num_poses; i++) {
+    for (int j = 6; j < num_dofs; j++) {
+      if (j != kWaistDof) base_poses[i * num_dofs + j] = poses[j];
+    }
+  }
+
+  // Check against dart
+  double max_evaluator_error = 0.0, max_engine_error = 0.0;
+  for (int i = 0; i < num_poses; i++) {
+    SetPositions(robot, &poses[i * num_dofs]);
+    Eigen::Vector3d com = BalanceControl::GetBodyCom(robot);
+    max_evaluator_error =
+        std::max(max_evaluator_error,
+                 (evaluator.Com(&poses[i * num_dofs]) - com).norm());
+    max_engine_error = std::max(max_engine_error, (engine.Com() - com).norm());
+  }
+  std::cout << "max error (m): ComEvaluator " << max_evaluator_error
+            << ", ComEngine " << max_engine_error << std::endl;
+
+  // Timing. The dart based ones include setting the positions, as in the
+  // control loop. The sums keep the computations from being optimized away
+  Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+  struct timespec t_start = aa_tm_now();
+  for (int i = 0; i < num_poses; i++) {
+    SetPositions(robot, &poses[i * num_dofs]);
+    sum += BalanceControl::GetBodyCom(robot);
+  }
+  double dart_time = SecondsSince(t_start);
+
+  t_start = aa_tm_now();
+  for (int i = 0; i < num_poses; i++) {
+    SetPositions(robot, &poses[i * num_dofs]);
+    sum += engine.Com();
+  }
+  double engine_time = SecondsSince(t_start);
+
+  t_start = aa_tm_now();
+  for (int i = 0; i < num_poses; i++) {
+    SetPositions(robot, &base_poses[i * num_dofs]);
+    sum += engine.Com();
+  }
+  double engine_base_time = SecondsSince(t_start);
+
+  t_start = aa_tm_now();
+  for (int i = 0; i < num_poses; i++)
+    sum += evaluator.Com(&poses[i * num_dofs]);
+  double evaluator_time = SecondsSince(t_start);
+
+  std::cout << "us/pose: GetBodyCom " << 1e6 * dart_time / num_poses
+            << ", ComEngine " << 1e6 * engine_time / num_poses
+            << " (base and waist only: " << 1e6 * engine_base_time / num_poses
+            << "), ComEvaluator " << 1e6 * evaluator_time / num_poses
+            << std::endl;
+  std::cout << "speedup of ComEvaluator over GetBodyCom: "
+            << dart_time / evaluator_time << " (checksum " << sum.sum() << ")"
+            << std::endl;
+  return (max_evaluator_error < 1e-9 ? 0 : 2);
+}
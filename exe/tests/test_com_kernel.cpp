@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_com_kernel.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of WeightedComSum() against a plain sum over the bodies, and
+ * of the scalar code giving the same bits as the AVX2 code
+ */
+
+#include <stdlib.h>  // rand(), srand(), RAND_MAX
+
+#include <cmath>     // fabs()
+#include <iostream>  // std::cout, std::endl
+#include <vector>    // std::vector
+
+#include "balancing/com_kernel.h"  // WeightedComSum(), kNumComKernelRows,
+                                   // WeightedComSumScalar()
+
+#include "check.h"  // CHECK(), num_failures
+
+/* ************************************************************************* */
+double Random() { return 2.0 * rand() / RAND_MAX - 1.0; }
+
+/* ************************************************************************* */
+int main() {
+  srand(1);
+  std::cout << "AVX2: " << (ComKernelUsesAvx2() ? "yes" : "no") << std::endl;
+  for (int num_bodies = 1; num_bodies <= 25; num_bodies++) {
+    int stride =
+        (num_bodies + kComKernelLanes - 1) / kComKernelLanes * kComKernelLanes;
+    std::vector<double> soa(kNumComKernelRows * stride, 0.0);
+    double expected[3] = {0.0, 0.0, 0.0};
+    for (int i = 0; i < num_bodies; i++) {
+      double R[9], t[3], mass_com[3], mass = 10.0 * (Random() + 1.0);
+      for (int k = 0; k < 9; k++) R[k] = Random();
+      for (int k = 0; k < 3; k++) t[k] = Random();
+      for (int k = 0; k < 3; k++) mass_com[k] = mass * 0.1 * Random();
+      for (int k = 0; k < 9; k++) soa[(kComRowR + k) * stride + i] = R[k];
+      for (int k = 0; k < 3; k++) soa[(kComRowT + k) * stride + i] = t[k];
+      for (int k = 0; k < 3; k++)
+        soa[(kComRowMassCom + k) * stride + i] = mass_com[k];
+      soa[kComRowMass * stride + i] = mass;
+      for (int row = 0; row < 3; row++) {
+        expected[row] += R[3 * row] * mass_com[0] +
+                         R[3 * row + 1] * mass_com[1] +
+                         R[3 * row + 2] * mass_com[2] + mass * t[row];
+      }
+    }
+
+    // Padding bodies have zero mass and add nothing
+    double sum[3];
+    WeightedComSum(&soa[0], stride, sum);
+    for (int row = 0; row < 3; row++)
+      CHECK(fabs(sum[row] - expected[row]) < 1e-12 * (1.0 + num_bodies * 20));
+
+    // Both paths agree up to rounding
+    double scalar_sum[3];
+    WeightedComSumScalar(&soa[0], stride, scalar_sum);
+    for (int row = 0; row < 3; row++) {
+      CHECK(fabs(scalar_sum[row] - sum[row]) <
+            1e-12 * (1.0 + num_bodies * 20));
+    }
+  }
+
+  std::cout << "test_com_kernel: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
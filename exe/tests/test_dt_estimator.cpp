@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_dt_estimator.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of DtEstimator: steps between timestamps, stale and late
+ * timestamps, and the filtered step
+ */
+
+#include <cmath>     // fabs()
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/dt_estimator.h"  // DtEstimator
+
+#include "check.h"  // CHECK(), num_failures
+
+/* ************************************************************************* */
+int main() {
+  DtEstimator estimator(0.002, 0.5, 0.05);
+
+  // The first sample has no previous one
+  CHECK(estimator.Update(10.0) == 0.002);
+
+  // Steps are the differences of the timestamps
+  CHECK(fabs(estimator.Update(10.003) - 0.003) < 1e-12);
+  CHECK(fabs(estimator.jitter() - 0.001) < 1e-12);
+  CHECK(fabs(estimator.filtered_dt() - 0.0025) < 1e-12);
+
+  // A timestamp that did not advance gets the filtered step
+  CHECK(estimator.Update(10.003) == estimator.filtered_dt());
+  CHECK(estimator.Update(10.001) == estimator.filtered_dt());
+  CHECK(estimator.num_stale() == 2);
+
+  // A late sample is clamped
+  CHECK(estimator.Update(11.0) == 0.05);
+  CHECK(estimator.num_clamped() == 1);
+
+  // A steady period is tracked with vanishing jitter
+  double time = 11.0;
+  for (int i = 0; i < 100; i++) estimator.Update(time += 0.002);
+  CHECK(fabs(estimator.filtered_dt() - 0.002) < 1e-9);
+  CHECK(fabs(estimator.jitter()) < 1e-9);
+  CHECK(estimator.num_samples() == 105);
+  CHECK(estimator.max_jitter() > 0.04 && estimator.jitter_rms() > 0.0);
+
+  std::cout << "test_dt_estimator: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
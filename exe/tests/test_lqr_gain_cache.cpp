@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_lqr_gain_cache.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of LqrGainCache: rounding of poses, hits and misses, and
+ * eviction of the least recently used pose
+ */
+
+#include <iostream>  // std::cout, std::endl
+
+#include <Eigen/Eigen>  // Eigen::Matrix<double, #, #>
+
+#include "balancing/lqr_gain_cache.h"  // LqrGainCache
+
+#include "check.h"  // CHECK(), num_failures
+
+typedef Eigen::Matrix<double, 4, 1> Vector4d;
+
+/* ************************************************************************* */
+// Key of the pose with the waist at waist and all other joints at 0
+LqrGainCache::Key WaistKey(const LqrGainCache& cache, double waist) {
+  double pose[LqrGainCache::kPoseSize] = {0.0};
+  pose[0] = waist;
+  LqrGainCache::Key key;
+  cache.MakeKey(pose, &key);
+  return key;
+}
+
+/* ************************************************************************* */
+int main() {
+  LqrGainCache cache(2, 0.01);
+  Vector4d gains;
+  CHECK(cache.capacity() == 2 && cache.size() == 0);
+
+  // Poses within the quantum share a key
+  CHECK(!cache.Lookup(WaistKey(cache, 0.100), &gains));
+  cache.Insert(WaistKey(cache, 0.100), Vector4d(1, 2, 3, 4));
+  CHECK(cache.Lookup(WaistKey(cache, 0.103), &gains) &&
+        gains == Vector4d(1, 2, 3, 4));
+  CHECK(!cache.Lookup(WaistKey(cache, 0.107), &gains));
+  CHECK(cache.hits() == 1 && cache.misses() == 2);
+
+  // A full cache evicts the pose used least recently
+  cache.Insert(WaistKey(cache, 0.2), Vector4d(5, 6, 7, 8));
+  CHECK(cache.Lookup(WaistKey(cache, 0.1), &gains));
+  cache.Insert(WaistKey(cache, 0.3), Vector4d(9, 10, 11, 12));
+  CHECK(cache.size() == 2);
+  CHECK(!cache.Lookup(WaistKey(cache, 0.2), &gains));
+  CHECK(cache.Lookup(WaistKey(cache, 0.1), &gains) &&
+        gains == Vector4d(1, 2, 3, 4));
+  CHECK(cache.Lookup(WaistKey(cache, 0.3), &gains) &&
+        gains == Vector4d(9, 10, 11, 12));
+
+  // Many evictions keep the chains consistent
+  LqrGainCache small(8, 0.01);
+  for (int i = 0; i < 1000; i++) {
+    LqrGainCache::Key key = WaistKey(small, 0.01 * (i % 37));
+    if (!small.Lookup(key, &gains)) small.Insert(key, Vector4d::Constant(i));
+  }
+  CHECK(small.size() == 8);
+  CHECK(small.hits() + small.misses() == 1000);
+
+  // Clear() forgets every pose
+  cache.Clear();
+  CHECK(cache.size() == 0);
+  CHECK(!cache.Lookup(WaistKey(cache, 0.1), &gains));
+  cache.Insert(WaistKey(cache, 0.1), Vector4d(4, 3, 2, 1));
+  CHECK(cache.Lookup(WaistKey(cache, 0.1), &gains) &&
+        gains == Vector4d(4, 3, 2, 1));
+
+  std::cout << "test_lqr_gain_cache: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
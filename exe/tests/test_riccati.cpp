@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_riccati.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of RiccatiSolver against the closed-form solution of a scalar
+ * system and the residual of the Riccati equation of a pendulum, cold and
+ * warm-started
+ */
+
+#include <cmath>     // sqrt(), fabs()
+#include <iostream>  // std::cout, std::endl
+
+#include <Eigen/Eigen>  // Eigen::Matrix<double, #, #>
+
+#include "balancing/riccati.h"  // RiccatiSolver
+
+#include "check.h"  // CHECK(), num_failures
+
+typedef Eigen::Matrix<double, 4, 4> Matrix4d;
+typedef Eigen::Matrix<double, 4, 1> Vector4d;
+typedef Eigen::Matrix<double, 1, 4> RowVector4d;
+typedef Eigen::Matrix<double, 1, 1> Matrix1d;
+
+/* ************************************************************************* */
+// Linearized wheeled inverted pendulum, unstable for gravity > 0
+void Pendulum(double gravity, Matrix4d* A, Vector4d* B) {
+  A->setZero();
+  (*A)(0, 1) = 1.0;
+  (*A)(1, 0) = gravity;
+  (*A)(2, 3) = 1.0;
+  (*A)(3, 0) = -0.3 * gravity;
+  *B << 0.0, -2.0, 0.0, 1.5;
+}
+
+/* ************************************************************************* */
+// Largest entry of A'P + PA - PBR^-1B'P + Q
+double Residual(const Matrix4d& A, const Vector4d& B, const Matrix4d& Q,
+                const Matrix1d& R, const Matrix4d& P) {
+  Matrix4d residual = A.transpose() * P + P * A -
+                      P * B * R.inverse() * B.transpose() * P + Q;
+  return residual.cwiseAbs().maxCoeff() / P.cwiseAbs().maxCoeff();
+}
+
+/* ************************************************************************* */
+int main() {
+  // x' = a x + u: P = r (a + sqrt(a^2 + q / r)) and K = P / r
+  const double a = 2.0, q = 3.0, r = 0.5;
+  RiccatiSolver<1, 1> scalar;
+  Eigen::Matrix<double, 1, 1> A1, B1, Q1, R1, K1 = Matrix1d::Zero();
+  A1 << a;
+  B1 << 1.0;
+  Q1 << q;
+  R1 << r;
+  CHECK(scalar.Solve(A1, B1, Q1, R1, &K1));
+  double P1 = r * (a + sqrt(a * a + q / r));
+  CHECK(fabs(scalar.P()(0, 0) - P1) < 1e-10 * P1);
+  CHECK(fabs(K1(0, 0) - P1 / r) < 1e-10 * P1);
+
+  // The pendulum from scratch, then warm-started as gravity changes slowly
+  Matrix4d A, Q = Vector4d(300, 96000, 30000, 90000).asDiagonal();
+  Vector4d B;
+  Matrix1d R;
+  R << 500;
+  RowVector4d K;
+  RiccatiSolver<4, 1> solver;
+  Pendulum(20.0, &A, &B);
+  CHECK(solver.Solve(A, B, Q, R, &K));
+  CHECK(!solver.warm_started());
+  CHECK(Residual(A, B, Q, R, solver.P()) < 1e-9);
+  CHECK((A - B * K).eigenvalues().real().maxCoeff() < 0.0);
+  int max_warm_iterations = 0;
+  bool all_warm = true;
+  for (int i = 1; i <= 100; i++) {
+    Pendulum(20.0 + 0.001 * i, &A, &B);
+    CHECK(solver.Solve(A, B, Q, R, &K));
+    CHECK(Residual(A, B, Q, R, solver.P()) < 1e-9);
+    all_warm &= solver.warm_started();
+    if (solver.iterations() > max_warm_iterations)
+      max_warm_iterations = solver.iterations();
+  }
+  CHECK(all_warm);
+  CHECK(max_warm_iterations <= 3);
+
+  // After Reset() the solver starts from scratch again
+  solver.Reset();
+  CHECK(solver.Solve(A, B, Q, R, &K) && !solver.warm_started());
+
+  std::cout << "test_riccati: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
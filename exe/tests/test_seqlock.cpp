@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_seqlock.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of SeqLock: versions, and consistent copies while another
+ * thread keeps writing
+ */
+
+#include <pthread.h>  // pthread_create(), pthread_join()
+#include <sched.h>    // sched_yield()
+
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/seqlock.h"  // SeqLock
+
+#include "check.h"  // CHECK(), num_failures
+
+/* ************************************************************************* */
+// Every element is the same number, so a torn copy shows as a mismatch
+struct Value {
+  unsigned long x[64];
+};
+
+const unsigned long kNumWrites = 20000;
+
+void* Writer(void* arg) {
+  SeqLock<Value>* lock = (SeqLock<Value>*)arg;
+  Value value;
+  for (unsigned long i = 1; i <= kNumWrites; i++) {
+    for (int j = 0; j < 64; j++) value.x[j] = i;
+    lock->Store(value);
+  }
+  return NULL;
+}
+
+/* ************************************************************************* */
+int main() {
+  // Versions count the values stored
+  SeqLock<int> counter(7);
+  int value = 0;
+  unsigned long version = 99;
+  CHECK(counter.version() == 0);
+  CHECK(counter.TryLoad(&value, &version) && value == 7 && version == 0);
+  counter.Store(8);
+  counter.Store(9);
+  CHECK(counter.Load(&value) == 2 && value == 9);
+
+  // A reader never sees a torn value, and versions never go back
+  Value zero;
+  for (int j = 0; j < 64; j++) zero.x[j] = 0;
+  SeqLock<Value> lock(zero);
+  pthread_t writer;
+  pthread_create(&writer, NULL, &Writer, &lock);
+  unsigned long last_version = 0, num_torn = 0, num_reads = 0;
+  bool versions_ordered = true;
+  while (last_version < kNumWrites) {
+    Value copy;
+    if (!lock.TryLoad(&copy, &version)) {
+      sched_yield();
+      continue;
+    }
+    num_reads++;
+    for (int j = 1; j < 64; j++) num_torn += (copy.x[j] != copy.x[0]);
+    versions_ordered &= (version >= last_version && copy.x[0] == version);
+    last_version = version;
+  }
+  pthread_join(writer, NULL);
+  CHECK(num_torn == 0);
+  CHECK(versions_ordered);
+  CHECK(num_reads > 0);
+
+  std::cout << "test_seqlock: " << num_failures << " failure(s)" << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_spsc_ring.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of SpscRing: full and empty rings, order, and a transfer
+ * between two threads
+ */
+
+#include <pthread.h>  // pthread_create(), pthread_join()
+#include <sched.h>    // sched_yield()
+
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/spsc_ring.h"  // SpscRing
+
+#include "check.h"  // CHECK(), num_failures
+
+/* ************************************************************************* */
+const int kNumTransfers = 100000;
+
+void* Producer(void* arg) {
+  SpscRing<int>* ring = (SpscRing<int>*)arg;
+  for (int i = 0; i < kNumTransfers; i++) {
+    while (!ring->TryPush(i)) sched_yield();
+  }
+  return NULL;
+}
+
+/* ************************************************************************* */
+int main() {
+  // Pushing into a full ring and popping from an empty one fail
+  SpscRing<int> ring(4);
+  int value;
+  CHECK(ring.capacity() == 4);
+  CHECK(!ring.TryPop(&value));
+  for (int i = 0; i < 4; i++) CHECK(ring.TryPush(i));
+  CHECK(!ring.TryPush(4));
+
+  // Elements come out in order, also across the wrap of the indices
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < 4; i++) {
+      CHECK(ring.TryPop(&value) && value == round * 4 + i);
+      CHECK(ring.TryPush((round + 1) * 4 + i));
+    }
+  }
+  for (int i = 0; i < 4; i++) CHECK(ring.TryPop(&value));
+  CHECK(!ring.TryPop(&value));
+
+  // Nothing is lost, duplicated or reordered between two threads
+  SpscRing<int> shared(64);
+  pthread_t producer;
+  pthread_create(&producer, NULL, &Producer, &shared);
+  int expected = 0;
+  bool in_order = true;
+  while (expected < kNumTransfers) {
+    if (!shared.TryPop(&value)) {
+      sched_yield();
+      continue;
+    }
+    in_order &= (value == expected);
+    expected++;
+  }
+  pthread_join(producer, NULL);
+  CHECK(in_order);
+  CHECK(!shared.TryPop(&value));
+
+  std::cout << "test_spsc_ring: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
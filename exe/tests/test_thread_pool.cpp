@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_thread_pool.cpp
+ * @author agent
+ * @date Oct 17, 2026
+ * @brief Tests of ThreadPool: every task runs once, tasks submitted by
+ * workers, and pools destroyed right after their tasks finish
+ */
+
+#include <atomic>    // std::atomic
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/thread_pool.h"  // ThreadPool
+
+#include "check.h"  // CHECK(), num_failures
+
+/* ************************************************************************* */
+int main() {
+  // Every task runs exactly once. A new pool per round also has its workers
+  // stop while others may still be looking for tasks to steal
+  for (int round = 0; round < 20; round++) {
+    std::atomic<long> num_runs(0);
+    ThreadPool pool(3);
+    for (int i = 0; i < 1000; i++) pool.Submit([&num_runs] { num_runs++; });
+    pool.Wait();
+    CHECK(num_runs.load() == 1000);
+  }
+
+  // Tasks submitted from within tasks are waited for as well
+  std::atomic<long> num_runs(0);
+  ThreadPool pool(2);
+  for (int i = 0; i < 100; i++) {
+    pool.Submit([&pool, &num_runs] {
+      num_runs++;
+      pool.Submit([&num_runs] { num_runs++; });
+    });
+  }
+  pool.Wait();
+  CHECK(num_runs.load() == 200);
+  CHECK(pool.num_threads() == 2);
+
+  std::cout << "test_thread_pool: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
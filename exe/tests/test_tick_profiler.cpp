@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file test_tick_profiler.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Tests of LatencyHistogram: exact small values, bounded relative
+ * error of percentiles, counts, and values past the last bucket
+ */
+
+#include <stdint.h>  // uint64_t
+
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/tick_profiler.h"  // LatencyHistogram
+
+#include "check.h"  // CHECK(), num_failures
+
+/* ************************************************************************* */
+int main() {
+  // Nothing recorded
+  LatencyHistogram histogram;
+  CHECK(histogram.count() == 0 && histogram.Percentile(0.5) == 0);
+
+  // Values below 16 ns have buckets of their own
+  for (uint64_t ns = 0; ns < 16; ns++) histogram.Record(ns);
+  CHECK(histogram.count() == 16 && histogram.max() == 15);
+  CHECK(histogram.Percentile(0.5) == 7);
+  CHECK(histogram.Percentile(1.0) == 15);
+  CHECK(histogram.mean() == 7.5);
+
+  // Percentiles of larger values are upper bounds within 1/16
+  for (uint64_t ns = 16; ns < (1ULL << 36); ns = ns * 3 / 2 + 1) {
+    histogram.Reset();
+    histogram.Record(ns);
+    uint64_t bound = histogram.Percentile(0.5);
+    CHECK(bound >= ns && bound <= ns + ns / 16);
+  }
+
+  // Percentiles of a uniform spread
+  histogram.Reset();
+  for (uint64_t us = 1; us <= 1000; us++) histogram.Record(us * 1000);
+  CHECK(histogram.count() == 1000 && histogram.max() == 1000000);
+  uint64_t p50 = histogram.Percentile(0.5);
+  uint64_t p99 = histogram.Percentile(0.99);
+  CHECK(p50 >= 500000 && p50 <= 500000 + 500000 / 16);
+  CHECK(p99 >= 990000 && p99 <= 990000 + 990000 / 16);
+  CHECK(histogram.Percentile(1.0) == 1000000);
+
+  // Values from 2^40 ns on share the last bucket, whose bound is 2^40 - 1
+  histogram.Reset();
+  histogram.Record((1ULL << 40) - 1);
+  CHECK(histogram.Percentile(1.0) == (1ULL << 40) - 1);
+  histogram.Record(1ULL << 40);
+  histogram.Record(1ULL << 41);
+  histogram.Record(1ULL << 63);
+  CHECK(histogram.count() == 4 && histogram.max() == (1ULL << 63));
+  CHECK(histogram.Percentile(0.25) == (1ULL << 40) - 1);
+  CHECK(histogram.Percentile(1.0) == (1ULL << 40) - 1);
+
+  std::cout << "test_tick_profiler: " << num_failures << " failure(s)"
+            << std::endl;
+  return (num_failures == 0 ? 0 : 1);
+}
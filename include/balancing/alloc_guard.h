@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file alloc_guard.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for alloc_guard.cpp that catches heap allocations in code
+ * that must not allocate
+ */
+
+#ifndef KRANG_BALANCING_ALLOC_GUARD_H_
+#define KRANG_BALANCING_ALLOC_GUARD_H_
+
+// Catches calls to the heap in code that must not make any, e.g. the part of
+// the main loop between the start of an iteration and the wheel command. Only
+// compiled in when configured with -Dbalancing_ALLOC_GUARD=COUNT or ABORT, in
+// which case the library replaces malloc(), calloc(), realloc() and free().
+// While the guard is armed on a thread, every such call made by that thread is
+// counted (COUNT) or aborts the program with a message and a core dump
+// (ABORT). Without the cmake option these functions do nothing
+
+// Starts watching the heap calls of the calling thread
+void AllocGuardArm();
+
+// Stops watching the heap calls of the calling thread. Returns the number of
+// calls made since AllocGuardArm()
+unsigned long AllocGuardDisarm();
+
+// Returns true if the guard is compiled in
+bool AllocGuardEnabled();
+
+#endif  // KRANG_BALANCING_ALLOC_GUARD_H_
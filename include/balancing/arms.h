@@ -44,10 +44,8 @@
 #ifndef KRANG_BALANCING_ARMS_H_
 #define KRANG_BALANCING_ARMS_H_
 
-#include <somatic.h>
-#include <somatic/daemon.h>
-#include <kore.hpp>
 #include "balancing_config.h"
+#include "hardware_interface.h"
 
 /* *********************************************************************************************
  */
@@ -71,8 +69,10 @@ class ArmControl {
                                       // gives problems when passing directly
                                       // const array pointers to it
 
-  ArmControl(somatic_d_t* daemon_cx_, Krang::Hardware* krang_,
-             BalancingConfig& params);
+  // hw may be NULL for an ArmControl that only holds the commands set by the
+  // events, e.g. the one of the balancing thread when UpperBodyExecutor
+  // controls the arms
+  ArmControl(HardwareInterface* hw_, BalancingConfig& params);
   ~ArmControl(){};
 
   void ControlArms();
@@ -81,14 +81,15 @@ class ArmControl {
   ArmMode mode;
   int preset_config_num;
   double command_vals[7];
+  unsigned long num_lock_unlock_events;  // calls of LockUnlockEvent() so far
 
  private:
   bool ArmResetIfNeeded(ArmMode& last_mode);
   void StopLeftArm();
   void StopRightArm();
 
-  somatic_d_t* daemon_cx;
-  Krang::Hardware* krang;
+  HardwareInterface* hw;
+  ArmMode last_mode;  // mode in the previous call to ControlArms()
   bool event_based_lock_unlock;
   bool halted;  // to manage halt/reset events when state_based_lock_unlock is
                 // not set
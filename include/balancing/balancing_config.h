@@ -48,7 +48,8 @@
 #include <memory>
 
 // Structure in which all configurable parameters are read at the beginning of
-// the program
+// the program. New fields are also to be listed in ConfigLayout() of
+// config_cache.cpp
 struct BalancingConfig {
   // Path to urdf file
   char urdfpath[1024];
@@ -77,6 +78,32 @@ struct BalancingConfig {
   Eigen::Matrix<double, 4, 4> lqrQ;
   Eigen::Matrix<double, 1, 1> lqrR;
 
+  // Where dynamic LQR gains come from: "online" solves them every iteration,
+  // "table" interpolates them from the table at lqrGainTablePath made by
+  // 06-lqr_gain_table, "background" keeps solving them on a separate thread
+  // and uses the latest solution
+  char lqrGainSource[16];
+  char lqrGainTablePath[1024];
+
+  // The table is only used while no arm joint is farther than
+  // lqrGainTableArmTolerance (rad) from the pose it was computed for. The
+  // gains are solved online otherwise
+  double lqrGainTableArmTolerance;
+
+  // Online LQR gains of the lqrGainCacheSize upper body poses used most
+  // recently are kept, with joint positions rounded to lqrGainCacheQuantum
+  // (rad). 0 disables the cache
+  int lqrGainCacheSize;
+  double lqrGainCacheQuantum;
+
+  // Online LQR gains are only solved again once a joint other than the base
+  // and wheels moved more than lqrRelinearizeTolerance (rad) from the pose of
+  // the last linearization. A negative value solves them every iteration
+  double lqrRelinearizeTolerance;
+
+  // Start the online LQR solver from the solution of its previous call
+  bool lqrWarmStart;
+
   // Balancing control mode transition parameters
   double imuSitAngle;
   double toBalThreshold;
@@ -89,6 +116,55 @@ struct BalancingConfig {
   // before use, and have to be halted in order to lock them
   bool manualArmLockUnlock;
 
+  // Rate (Hz) at which the main loop is run. If not positive, the loop runs
+  // as fast as its body allows
+  double controlRate;
+
+  // The arms, waist and torso are controlled once every upperBodyRateDivider
+  // iterations of the main loop, on a thread of their own if the loop runs
+  // at a fixed rate and the robot is not simulated in-process
+  int upperBodyRateDivider;
+
+  // If sensorTimeStep is set, the time step of the controller is the time
+  // between the timestamps of consecutive sensor samples (see
+  // dt_estimator.h), clamped to maxTimeStep (s). dtFilterGain is the weight of
+  // a new step in the filtered step against which jitter is measured
+  bool sensorTimeStep;
+  double dtFilterGain;
+  double maxTimeStep;
+
+  // Joystick input is dropped (thumbs zeroed, buttons free) once no message has
+  // arrived for joystickTimeoutMs (ms). Not positive keeps the last input
+  double joystickTimeoutMs;
+
+  // File in which the flight recorder keeps the latest iterations of the main
+  // loop and how many iterations it keeps. Recording is off if the path is
+  // empty
+  char flightRecorderPath[1024];
+  int flightRecorderCapacity;
+
+  // In simulation mode, simulate the robot inside this process in lockstep
+  // with the controller instead of talking to krang-sim-ach
+  bool inProcessSimulation;
+
+  // Reload the gains and thresholds whenever the cfg file changes (see
+  // config_watcher.h)
+  bool reloadConfig;
+
+  // Real-time setup of 01-balancing (see rt_setup.h). The main loop runs with
+  // SCHED_FIFO at rtPriority (0 keeps SCHED_OTHER) on the cpus listed in
+  // rtControlCpus and all other threads on those in rtAuxiliaryCpus, both
+  // lists of cpu numbers separated by spaces ("" leaves the affinity alone).
+  // rtLockMemory locks all memory of the process, and rtPrefaultStackKb and
+  // rtPrefaultHeapKb are touched at startup so that the loop does not page
+  // fault on them
+  int rtPriority;
+  char rtControlCpus[256];
+  char rtAuxiliaryCpus[256];
+  bool rtLockMemory;
+  int rtPrefaultStackKb;
+  int rtPrefaultHeapKb;
+
   bool is_simulation_;
   double sim_dt_;
   double sim_max_input_current_;
@@ -99,6 +175,10 @@ struct BalancingConfig {
 // where the parameters are stored
 void ReadConfigParams(const char* config_file, BalancingConfig* params);
 
+// Same as ReadConfigParams() but returns false instead of asserting if the
+// file cannot be parsed, a parameter is missing or a list of numbers is short
+bool TryReadConfigParams(const char* config_file, BalancingConfig* params);
+
 // Read the parameter named "time_step" from the give config file
 double ReadConfigTimeStep(const char* config_file);
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file com_engine.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for com_engine.cpp that computes the center of mass of the
+ * robot without the wheels, reusing the parts of the previous computation
+ * that are still valid
+ */
+
+#ifndef KRANG_BALANCING_COM_ENGINE_H_
+#define KRANG_BALANCING_COM_ENGINE_H_
+
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <Eigen/Eigen>    // Eigen::Vector3d
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr, BodyNode
+
+// Computes the center of mass of the robot without the wheels. Every body
+// keeps the mass-weighted com of the subtree it roots, in its own frame. A
+// subtree is only recomputed when the position of a joint inside it changed
+// since the previous call, so with the arms still only the base, waist and
+// torso are visited. The body nodes and masses are looked up once, in the
+// constructor and UpdateMassProperties()
+class ComEngine {
+ public:
+  // The bodies named in excluded (e.g. the wheels) and their subtrees are left
+  // out of the com
+  ComEngine(dart::dynamics::SkeletonPtr robot,
+            const std::vector<std::string>& excluded);
+  ~ComEngine() {}
+
+  // Reads the masses and local coms of the bodies again. Needed after they
+  // are changed, e.g. by ApplyComParameters()
+  void UpdateMassProperties();
+
+  // Returns the com in the world frame for the current pose of the skeleton
+  Eigen::Vector3d Com();
+
+  // Getters
+  double mass() const { return mass_; }
+  int num_recomputed() const { return num_recomputed_; }  // in the last Com()
+
+ private:
+  struct Body {
+    dart::dynamics::BodyNode* node;
+    int parent;                 // index in bodies_, -1 for the root
+    std::vector<int> children;  // indices in bodies_
+    std::vector<int> dofs;      // dofs of the joint to the parent
+    std::vector<double> q;      // their positions at the last update
+    double mass;                // of the body alone
+    Eigen::Vector3d mass_com;   // mass times local com of the body alone
+    double subtree_mass;
+    Eigen::Vector3d subtree_mass_com;  // sum of mass times com over the
+                                       // subtree, in the frame of the body
+  };
+
+  // Adds node and its subtree to bodies_ unless excluded
+  void AddSubtree(dart::dynamics::BodyNode* node, int parent,
+                  const std::vector<std::string>& excluded);
+
+  // Returns true if a dof of the joint of body moved since the last update,
+  // and stores the new positions
+  bool JointMoved(Body* body);
+
+  dart::dynamics::SkeletonPtr robot_;
+  std::vector<Body> bodies_;  // parents always before their children
+  std::vector<char> changed_;  // per body, if its subtree changed as seen
+                               // from its parent in the last Com()
+  double mass_;
+  bool valid_;  // false until the subtrees are computed once
+  int num_recomputed_;
+};
+
+#endif  // KRANG_BALANCING_COM_ENGINE_H_
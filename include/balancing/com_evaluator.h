@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file com_evaluator.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for com_evaluator.cpp that evaluates the center of mass of
+ * the robot directly from its joint angles
+ */
+
+#ifndef KRANG_BALANCING_COM_EVALUATOR_H_
+#define KRANG_BALANCING_COM_EVALUATOR_H_
+
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <Eigen/Eigen>    // Eigen::Matrix3d, Eigen::Vector3d
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr
+
+// Evaluates the center of mass of the robot from its joint angles without
+// dart. Compile() flattens the kinematic chain into a list of links, parents
+// first, each with the fixed transforms on either side of its joint and the
+// mass and mass-weighted local com of its body, i.e. the beta parameters if
+// they were applied to the skeleton. Com() then only composes one rotation
+// per joint with these transforms and sums the mass-weighted coms of the
+// bodies with the vectorized kernel of com_kernel.h
+class ComEvaluator {
+ public:
+  ComEvaluator() {}
+  ~ComEvaluator() {}
+
+  // Flattens the chain of robot with its current masses and local coms,
+  // leaving out the bodies named in excluded and their subtrees. Returns false
+  // if the chain has joints other than free, revolute and weld joints, or the
+  // root is not a free joint
+  bool Compile(dart::dynamics::SkeletonPtr robot,
+               const std::vector<std::string>& excluded);
+
+  // Returns the com in the world frame. q holds the positions of all dofs of
+  // the skeleton, in the order of the skeleton
+  Eigen::Vector3d Com(const double* q);
+
+  // Returns the moment of inertia of the bodies about the line through point
+  // along the unit vector axis, both in the world frame, at the pose of the
+  // latest Com()
+  double InertiaAbout(const Eigen::Vector3d& point,
+                      const Eigen::Vector3d& axis) const;
+
+  // Getters. The com and the world transform of the root body are those of
+  // the latest Com()
+  bool empty() const { return links_.empty(); }
+  double mass() const { return mass_; }
+  int num_links() const { return links_.size(); }
+  const Eigen::Vector3d& com() const { return com_; }
+  const Eigen::Matrix3d& root_rotation() const { return R_[0]; }
+  const Eigen::Vector3d& root_translation() const { return t_[0]; }
+
+ private:
+  enum JointType { kFree, kRevolute, kWeld };
+
+  // Transform of the child body in the frame of the parent body:
+  // parent_R/t, then the joint, then child_R/t
+  struct Link {
+    int parent;      // index in links_, -1 for the root
+    JointType type;
+    int dof;         // first dof of the joint in the skeleton
+    Eigen::Vector3d axis;  // of a revolute joint
+    Eigen::Matrix3d parent_R;  // parent body to joint
+    Eigen::Vector3d parent_t;
+    Eigen::Matrix3d child_R;  // joint to child body
+    Eigen::Vector3d child_t;
+    double mass;
+    Eigen::Vector3d mass_com;  // mass times local com
+    Eigen::Vector3d com;       // local com
+    Eigen::Matrix3d inertia;   // moment of inertia about the com, body frame
+  };
+
+  std::vector<Link> links_;
+  std::vector<Eigen::Matrix3d> R_;  // world transforms of the bodies, kept to
+  std::vector<Eigen::Vector3d> t_;  // avoid allocating in Com()
+  std::vector<double> soa_;  // rows of WeightedComSum(), per link
+  int stride_;               // length of a row, links padded
+  double mass_;
+  Eigen::Vector3d com_;
+};
+
+#endif  // KRANG_BALANCING_COM_EVALUATOR_H_
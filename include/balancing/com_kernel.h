@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file com_kernel.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for com_kernel.cpp that sums the mass-weighted coms of many
+ * bodies with vector instructions
+ */
+
+#ifndef KRANG_BALANCING_COM_KERNEL_H_
+#define KRANG_BALANCING_COM_KERNEL_H_
+
+// Bodies handled by one step of the vectorized kernel. Arrays passed to
+// WeightedComSum() are padded to a multiple of this
+const int kComKernelLanes = 4;
+
+// Rows of the structure-of-arrays layout used by WeightedComSum(). Each row
+// holds one quantity for every body
+enum ComKernelRow {
+  kComRowR = 0,          // 9 rows: world rotation of the body, row-major
+  kComRowT = 9,          // 3 rows: world position of the body
+  kComRowMassCom = 12,   // 3 rows: mass times local com
+  kComRowMass = 15,      // mass
+  kNumComKernelRows = 16
+};
+
+// Computes sum over bodies of R * mass_com + mass * t, i.e. mass times the
+// world com of the bodies. soa holds kNumComKernelRows rows of stride
+// elements each, stride being a multiple of kComKernelLanes, and the padding
+// bodies must have zero mass and mass_com. Uses AVX2 when the library was
+// built with balancing_AVX2 and the cpu has it, and scalar code otherwise.
+// The two may differ in the last bits, so results are only bit-exact across
+// cpus that take the same path
+void WeightedComSum(const double* soa, int stride, double* sum);
+
+// Scalar code of WeightedComSum(), used when AVX2 is not
+void WeightedComSumScalar(const double* soa, int stride, double* sum);
+
+// Returns true if WeightedComSum() uses AVX2
+bool ComKernelUsesAvx2();
+
+#endif  // KRANG_BALANCING_COM_KERNEL_H_
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file config_cache.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for config_cache.cpp that keeps the parsed configuration
+ * parameters in a binary file for fast restarts
+ */
+
+#ifndef KRANG_BALANCING_CONFIG_CACHE_H_
+#define KRANG_BALANCING_CONFIG_CACHE_H_
+
+#include <stdint.h>  // uint32_t, uint64_t
+
+#include <Eigen/Eigen>  // Eigen::MatrixXd
+
+#include "balancing_config.h"  // BalancingConfig
+
+// Bump when the layout of the cache file changes. Changes of BalancingConfig
+// are caught by the layout hash in the header
+const uint32_t kConfigCacheVersion = 2;
+
+// Same as ReadConfigParams(), followed by reading the CoM parameters at
+// params->comParametersPath into beta (left empty if the path is empty). The
+// result is kept in config_file + ".cache", which is memory-mapped instead on
+// later calls as long as neither the cfg file nor the CoM parameters file
+// changed (same mtime, size and FNV-1a hash), is_simulation_ is the same, and
+// BalancingConfig has the same fields at the same offsets in this build.
+// Returns true if the cache was used
+bool ReadConfigParamsCached(const char* config_file, BalancingConfig* params,
+                            Eigen::MatrixXd* beta);
+
+#endif  // KRANG_BALANCING_CONFIG_CACHE_H_
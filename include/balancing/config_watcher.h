@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file config_watcher.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for config_watcher.cpp that reloads the gains and thresholds
+ * when the cfg file changes
+ */
+
+#ifndef KRANG_BALANCING_CONFIG_WATCHER_H_
+#define KRANG_BALANCING_CONFIG_WATCHER_H_
+
+#include <pthread.h>  // pthread_t
+
+#include <atomic>  // std::atomic
+
+#include <Eigen/Eigen>  // Eigen::Matrix<double, #, #>
+
+#include "balancing_config.h"  // BalancingConfig
+#include "control.h"           // ControlTuning
+#include "seqlock.h"           // SeqLock
+
+// Watches the cfg file with inotify on a thread of its own. Whenever the file
+// is written or replaced, it is parsed again and, if ValidateControlTuning()
+// accepts its gains and thresholds, the lqr hack ratios are computed for them
+// here and they are published for the control thread
+// to pick up between two iterations. The control thread never waits: if the
+// watcher is publishing right then, the new tuning is picked up one iteration
+// later. Changes to the other parameters take effect on restart
+class ConfigWatcher {
+ public:
+  // config_file: the cfg file params were read from
+  // hack_A, hack_B: linearization the lqr hack ratios are computed from
+  ConfigWatcher(const char* config_file, const BalancingConfig& params,
+                const Eigen::Matrix<double, 4, 4>& hack_A,
+                const Eigen::Matrix<double, 4, 1>& hack_B);
+  ~ConfigWatcher();
+
+  // Returns false, printing why, if the file cannot be watched
+  bool Start();
+  void Stop();
+
+  // Called by the control thread. Copies the tuning of the latest reload if
+  // it was not taken yet
+  bool NewTuning(ControlTuning* tuning);
+
+  // Getters
+  bool running() const { return running_.load(); }
+  unsigned long num_reloads() const { return tuning_.version(); }
+  unsigned long num_rejected() const { return num_rejected_.load(); }
+
+ private:
+  // Not copyable
+  ConfigWatcher(const ConfigWatcher&);
+  ConfigWatcher& operator=(const ConfigWatcher&);
+
+  // Body of the watcher thread
+  static void* Run(void* arg);
+
+  // Parses the file and publishes its tuning if it is valid
+  void Reload();
+
+  char config_file_[1024];
+  const char* file_name_;  // part of config_file_ after the directory
+  BalancingConfig params_;  // of the latest reload, watcher thread only
+  Eigen::Matrix<double, 4, 4> hack_A_;  // watcher thread only
+  Eigen::Matrix<double, 4, 1> hack_B_;  // watcher thread only
+
+  SeqLock<ControlTuning> tuning_;  // written by the watcher thread
+  unsigned long taken_version_;    // control thread only
+
+  int inotify_fd_;
+  std::atomic<unsigned long> num_rejected_;
+  std::atomic<bool> running_;
+  pthread_t thread_;
+};
+
+#endif  // KRANG_BALANCING_CONFIG_WATCHER_H_
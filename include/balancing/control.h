@@ -44,17 +44,116 @@
 #ifndef KRANG_BALANCING_CONTROL_H_
 #define KRANG_BALANCING_CONTROL_H_
 
+#include <stdint.h>  // uint64_t
+
 #include <Eigen/Eigen>    // Eigen::MatrixXd, Eigen::Matrix<double, #, #>
 #include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr
-#include <kore.hpp>       // Krang::Hardware
 
-#include "balancing_config.h"  // BalancingConfig
+#include "balancing_config.h"    // BalancingConfig
+#include "com_engine.h"          // ComEngine
+#include "com_evaluator.h"       // ComEvaluator
+#include "dt_estimator.h"        // DtEstimator
+#include "hardware_interface.h"  // HardwareInterface
+#include "lqr_gain_cache.h"      // LqrGainCache
+#include "lqr_gains.h"           // LqrGainTable, WipParameters
+#include "lqr_worker.h"          // LqrWorker
+#include "riccati.h"             // RiccatiSolver
+#include "sensors.h"             // SensorSample
+
+// Copy of the controller variables of one iteration, stored as plain arrays so
+// that it can be handed to other threads and written to files as is
+struct ControlSnapshot {
+  double state[6];      // th, dth, forw, dforw, spin, dspin
+  double ref_state[6];  // reference for each element of state
+  double error[6];      // state - ref_state
+  double pd_gains[6];   // gains used in the iteration
+  double com[3];        // body center of mass relative to the wheel axle
+  double joystick_forw, joystick_spin;  // motion control references
+  double control_input[2];  // currents for the left and right wheel
+  double imu;               // imu angle (rad)
+  double waist_angle;       // position of the first waist motor (rad)
+  double dt;                // time step (s)
+  double dt_filtered;       // expected time step from the sensor timestamps
+  double dt_jitter;         // dt - dt_filtered of the previous iteration
+  double lqr_gain_age;      // age of the lqr gains from LqrWorker (s)
+  uint64_t lqr_cache_hits;    // lookups of LqrGainCache so far
+  uint64_t lqr_cache_misses;
+  uint64_t lqr_linearizations;  // online lqr gains solved so far
+  uint64_t lqr_reuses;  // online lqr gains reused for a nearby pose so far
+  uint64_t lqr_table_misses;  // iterations with the arms away from the pose
+                              // of the lqr gain table so far
+  int balance_mode;         // BalanceControl::BalanceMode
+  int dynamic_lqr;          // 1 if online lqr gains are used
+};
+
+// Dump a snapshot on the screen in the format of BalanceControl::Print()
+void PrintControlSnapshot(const ControlSnapshot& snapshot);
+
+// Sets the masses and local coms of the bodies of robot from CoM parameters.
+// beta_params: list of all CoM parameters for each body (mass and mass times
+// local com)
+// num_body_params: how many parameters per body
+void ApplyComParameters(const Eigen::MatrixXd& beta_params,
+                        int num_body_params,
+                        dart::dynamics::SkeletonPtr robot);
+
+// The part of the controller variables that keyboard and joystick events may
+// change between iterations. Recording it before BalancingController() is
+// called allows an iteration to be replayed without replaying the events
+struct ControlEventState {
+  int balance_mode;                     // BalanceControl::BalanceMode
+  double ref_forw, ref_spin;            // reference positions
+  double pd_gains[6];                   // gains of the current mode
+  double joystick_forw, joystick_spin;  // motion control references
+  int stood_up_timer;                   // iterations spent stood up in STAND
+  double lqr_hack_ratios[4];            // depend on the pose at startup
+};
+
+// True if a and b hold the same values
+bool SameEventState(const ControlEventState& a, const ControlEventState& b);
+
+// The gains and thresholds of the controller that can be changed while it
+// runs, e.g. when the cfg file is reloaded (see config_watcher.h). Plain data
+// so that it can be handed between threads
+struct ControlTuning {
+  double pd_gains[6][6];        // per BalanceControl::BalanceMode
+  double joystick_gains[6][2];  // per BalanceControl::BalanceMode
+  double lqr_q[4];              // diagonal of the Q matrix for LQR
+  double lqr_r;                 // R matrix for LQR
+  double to_bal_threshold;      // see BalancingConfig
+  double start_bal_threshold_lo;
+  double start_bal_threshold_hi;
+  double imu_sit_angle;
+  double waist_hi_lo_threshold;
+  double lqr_hack_ratios[4];    // see ComputeLqrHackRatios()
+};
+
+// Copies the tunable part of params into tuning. The lqr hack ratios are set
+// to 1
+void GetControlTuning(const BalancingConfig& params, ControlTuning* tuning);
+
+// Sets the lqr hack ratios of tuning to its STAND pd gains over the lqr gains
+// of its costs for the linearized dynamics A and B. Takes one lqr solve, so it
+// is done before the tuning is handed to the control thread. Returns false if
+// a ratio is not finite
+bool ComputeLqrHackRatios(const Eigen::Matrix<double, 4, 4>& A,
+                          const Eigen::Matrix<double, 4, 1>& B,
+                          ControlTuning* tuning);
+
+// Returns false, printing why, if the controller should not be run with tuning
+bool ValidateControlTuning(const ControlTuning& tuning);
 
 class BalanceControl {
  public:
-  BalanceControl(Krang::Hardware* krang_, dart::dynamics::SkeletonPtr robot_,
-                 BalancingConfig& params);
-  ~BalanceControl() {}
+  // hw may be NULL to run the controller offline, in which case the state is
+  // updated only with UpdateState(const SensorSample&) and the skeleton is
+  // expected to be set to the initial pose before construction. beta: the
+  // CoM parameters at params.comParametersPath if already read (see
+  // config_cache.h), or NULL to read them here
+  BalanceControl(HardwareInterface* hw, dart::dynamics::SkeletonPtr robot_,
+                 BalancingConfig& params,
+                 const Eigen::MatrixXd* beta = NULL);
+  ~BalanceControl();
 
   // The states of our state machine. We use the name "mode" instead of "state"
   // because state is already being used to name the state of the wheeled
@@ -75,13 +174,32 @@ class BalanceControl {
   // constructor
   double ElapsedTimeSinceLastCall();
 
+  // Sets the time step used by the controller for the current iteration. Used
+  // instead of ElapsedTimeSinceLastCall() when the main loop runs at a fixed
+  // rate. Returns the time step for convenience
+  double SetTimeStep(double dt);
+
   // Get body only com (without wheels) in world frame)
-  Eigen::Vector3d GetBodyCom(dart::dynamics::SkeletonPtr robot);
+  static Eigen::Vector3d GetBodyCom(dart::dynamics::SkeletonPtr robot);
 
   // Reads the sensors of the robot and updates the state of the wheeled
-  // inverted pendulum. Involves computation of the center of mass
+  // inverted pendulum. Involves computation of the center of mass. With
+  // sensorTimeStep set, the time step becomes the time since the previous
+  // sample
   void UpdateState();
 
+  // Same as UpdateState() but with sensor readings given instead of read from
+  // the robot, e.g. when replaying a recording. Sets the skeleton to the
+  // joint positions in the sample
+  void UpdateState(const SensorSample& sample);
+
+  // Copy the sensor readings used in the latest UpdateState()
+  void GetSensorSample(SensorSample* sample) const { *sample = sensors_; }
+
+  // Get and set the variables that events may change between iterations
+  void GetEventState(ControlEventState* event_state) const;
+  void SetEventState(const ControlEventState& event_state);
+
   // Sets reference positions for heading and spin the current values
   void CancelPositionBuiltup();
 
@@ -94,6 +212,19 @@ class BalanceControl {
   // current mode of the state machine
   void BalancingController(double* control_input);
 
+  // Replaces the gains and thresholds. Meant to be called between iterations.
+  // New lqr costs drop the online lqr gains solved so far, and the gain table
+  // if it was made with other costs. The lqr hack ratios are taken as they are
+  void SetTuning(const ControlTuning& tuning);
+
+  // Copy the gains and thresholds in use, incl. pd gains changed by events
+  void GetTuning(ControlTuning* tuning) const;
+
+  // Linearization at the startup pose from which the lqr hack ratios are
+  // computed (see ComputeLqrHackRatios())
+  const Eigen::Matrix<double, 4, 4>& hack_A() const { return hack_A_; }
+  const Eigen::Matrix<double, 4, 1>& hack_B() const { return hack_B_; }
+
   // Change a gain among the current pd_gains_
   // index: represents the targeted gain
   // change: the amount by which to change the gain
@@ -102,6 +233,10 @@ class BalanceControl {
   // Dump relevant info on the screen
   void Print();
 
+  // Copy the variables of the latest iteration into snapshot. Cheap enough to
+  // be called from the control loop
+  void Snapshot(ControlSnapshot* snapshot) const;
+
   // Triggers Stand/Sit event. If in Ground Lo mode, switches to Stand mode. If
   // in Bal Lo mode, switches to Sit mode. If some guards are satisfied.
   void StandSitEvent();
@@ -127,6 +262,28 @@ class BalanceControl {
   // num_body_params: how many parameters per body
   void SetComParameters(Eigen::MatrixXd beta_params, int num_body_params);
 
+  // Computes the state of the wheeled inverted pendulum from sensors_ and the
+  // pose of the skeleton
+  void ComputeState();
+
+  // Sets the wheel and motor parameters of wip_ and the axle in the frame of
+  // the root body, from the current pose. Returns false if the wheels do not
+  // have revolute joints
+  bool InitWipParameters();
+
+  // Sets the body parameters of wip_ from the pose of the latest
+  // ComEvaluator::Com()
+  void ComputeWipParameters();
+
+  // Returns true if no joint other than the base and wheels moved more than
+  // relinearize_tolerance_ since the last linearization
+  bool LinearizationValid() const;
+
+  // Returns true if the arms are within table_arm_tolerance_ of the pose
+  // lqr_gain_table_ was computed for. Counts the iterations in which they are
+  // not
+  bool ArmsAtTablePose();
+
   // Set the forward and spin pos/vel references based on the respective control
   // references
   void UpdateReference(const double& forw, const double& spin);
@@ -140,17 +297,34 @@ class BalanceControl {
                       const Eigen::Matrix<double, 6, 1>& error,
                       double* control_input);
 
+  // The controller of one mode: references, errors, gains and currents
+  // followed by the transitions out of the mode. What differs between modes
+  // is given at compile time by ModePolicy<mode> in control.cpp
+  template <BalanceMode mode>
+  void ModeController(double* control_input);
+
+  // Transitions out of mode after its controller ran. Specialized for the
+  // modes that have any
+  template <BalanceMode mode>
+  void ModeTransition();
+
+  // ModeController() of every mode, indexed by BalanceMode
+  typedef void (BalanceControl::*ModeControllerFn)(double*);
+  static const ModeControllerFn kModeControllers[NUM_MODES];
+
   // Based on the current state of the full robot, computes linearized dynamics
   // of the simplified robot (i.e. the wheeled inverted pendulum) and then
   // computes the LQR gains on the linearized dynamics using costs lqrQ_ and
   // lqrR_ to return a 4-element vector comprising the LQR gains for theta,
   // dtheta, x, dx respectively
-  Eigen::MatrixXd ComputeLqrGains();
+  Eigen::Matrix<double, 4, 1> ComputeLqrGains();
 
  private:
   BalanceMode balance_mode_;  // Current mode of the state machine
   Eigen::Matrix<double, 4, 4>
       lqr_hack_ratios_;  // gains_that_work/computed_lqr_gains
+  Eigen::Matrix<double, 4, 4> hack_A_;  // linearization at the startup pose,
+  Eigen::Matrix<double, 4, 1> hack_B_;  // from which the ratios are computed
   Eigen::Matrix<double, 6, 1> pd_gains_, ref_state_, state_,
       error_;  // state: th, dth, forw, dforw, spin, dspin
   Eigen::Matrix<double, 6, 1>
@@ -165,13 +339,45 @@ class BalanceControl {
   struct timespec t_now_, t_prev_;
   double dt_;
   double u_theta_, u_x_, u_spin_;  // individual components of the wheel current
+  double control_input_[2];        // latest wheel currents
+  SensorSample sensors_;           // sensor readings of the latest iteration
+  int stood_up_timer_;  // iterations for which krang has looked stood up in
+                        // STAND mode
 
-  Krang::Hardware*
-      krang_;  // interface to hardware components (sensors and motors)
+  HardwareInterface* hw_;  // interface to the sensors of the robot
   dart::dynamics::SkeletonPtr robot_;  // dart object with krang's skeleton
+  ComEngine com_engine_;  // com of robot_ without the wheels
+  ComEvaluator com_evaluator_;  // the same in closed form from joint angles
+  bool use_com_evaluator_;      // false if it could not be compiled
+  bool sensor_time_step_;       // dt_ from the sensor timestamps
+  DtEstimator dt_estimator_;    // of the time step from sensor timestamps
 
   bool dynamic_lqr_;  // if true, online pose-dependent lqr gains will be used
                       // instead of the fixed gains specified in the config file
+  bool use_lqr_gain_table_;      // lqr gains from lqr_gain_table_
+  LqrGainTable lqr_gain_table_;  // precomputed pose-dependent lqr gains
+  double table_arm_tolerance_;   // arm joint error (rad) up to which the table
+                                 // is used
+  uint64_t num_table_misses_;    // iterations with the arms away from the
+                                 // pose of the table
+  uint64_t com_parameters_hash_;  // HashComParameters() of the CoM parameters
+  RiccatiSolver<4, 1> riccati_;  // online lqr solver, warm-started from the
+                                 // previous iteration
+  bool lqr_warm_start_;          // if false, riccati_ starts from scratch
+  bool use_wip_model_;  // online lqr gains from the closed-form linearization
+                        // of wip_ instead of dart
+  WipParameters wip_;   // lumped parameters of the wheeled inverted pendulum
+  Eigen::Vector3d axle_point_, axle_axis_;  // wheel axle in the root body
+  LqrWorker* lqr_worker_;  // solves lqr gains in the background, may be NULL
+  double lqr_gain_age_;    // age of the latest gains from lqr_worker_ (s)
+  LqrGainCache* lqr_gain_cache_;  // online lqr gains of recent poses, may be
+                                  // NULL
+  double relinearize_tolerance_;  // joint motion (rad) after which online
+                                  // lqr gains are solved again
+  bool has_linearization_;        // lin_pose_ and lin_gains_ are set
+  double lin_pose_[kMaxSensorDofs];         // pose of the last linearization
+  Eigen::Matrix<double, 4, 1> lin_gains_;  // online lqr gains solved there
+  uint64_t num_linearizations_, num_linearization_reuses_;
   Eigen::Matrix<double, 4, 4> lqrQ_;  // Q matrix for LQR
   Eigen::Matrix<double, 1, 1> lqrR_;  // R matrix for LQR
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file dt_estimator.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for dt_estimator.cpp that derives the time step of the
+ * control loop from the timestamps of the sensor samples
+ */
+
+#ifndef KRANG_BALANCING_DT_ESTIMATOR_H_
+#define KRANG_BALANCING_DT_ESTIMATOR_H_
+
+// Time step of the control loop from the timestamps of consecutive sensor
+// samples. The step of an iteration is the time between its sample and the
+// previous one, so that references integrated with it follow the sensors even
+// if the loop was preempted. A low-pass filtered step is kept as the expected
+// period. It is used whenever the timestamps cannot be trusted (first sample,
+// a timestamp that did not advance), and the deviation of every step from it
+// is accumulated as the jitter of the loop
+class DtEstimator {
+ public:
+  // initial_dt: expected period until samples arrive (s). filter_gain: weight
+  // of a new step in the filtered one, in (0, 1]. max_dt: longest step used
+  // (s), longer ones are clamped to it
+  DtEstimator(double initial_dt, double filter_gain, double max_dt);
+  ~DtEstimator() {}
+
+  // Adds the timestamp (s) of a new sample and returns the step to use for
+  // its iteration
+  double Update(double time);
+
+  // Dump the jitter statistics on the screen
+  void PrintStats() const;
+
+  // Getters
+  double dt() const { return dt_; }  // latest step returned by Update()
+  double filtered_dt() const { return filtered_dt_; }
+  double jitter() const { return jitter_; }  // latest step minus the filtered
+                                             // step before it
+  double max_jitter() const { return max_jitter_; }  // largest |jitter()|
+  double jitter_rms() const;
+  unsigned long num_samples() const { return num_samples_; }
+  unsigned long num_stale() const { return num_stale_; }  // did not advance
+  unsigned long num_clamped() const { return num_clamped_; }  // > max_dt
+
+ private:
+  double filter_gain_, max_dt_;
+  bool has_time_;
+  double last_time_;
+  double dt_, filtered_dt_, jitter_;
+  double max_jitter_, sum_squared_jitter_;
+  unsigned long num_samples_, num_steps_, num_stale_, num_clamped_;
+};
+
+#endif  // KRANG_BALANCING_DT_ESTIMATOR_H_
@@ -57,9 +57,10 @@
 /* ******************************************************************************
  */
 /// Events
-bool Events(KbShared& kb_shared, Joystick& joystick, bool* start,
-            BalanceControl* balance_control, Somatic__WaistMode* waist_mode,
-            TorsoState* torso_state, ArmControl* arm_control);
+bool Events(KbShared& kb_shared, const JoystickState& joystick,
+            bool* start, BalanceControl* balance_control,
+            Somatic__WaistMode* waist_mode, TorsoState* torso_state,
+            ArmControl* arm_control);
 
 /* ********************************************************************************************
  */
@@ -70,7 +71,8 @@ void KeyboardEvents(KbShared& kb_shared, bool* start_,
 /* ******************************************************************************
  */
 /// Joystick Events
-bool JoystickEvents(Joystick& joystick, BalanceControl* balance_control,
+bool JoystickEvents(const JoystickState& joystick,
+                    BalanceControl* balance_control,
                     Somatic__WaistMode* waist_mode, TorsoState* torso_state,
                     ArmControl* arm_control);
 
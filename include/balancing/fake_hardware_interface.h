@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file fake_hardware_interface.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for fake_hardware_interface.cpp that implements the hardware
+ * interface in memory
+ */
+
+#ifndef KRANG_BALANCING_FAKE_HARDWARE_INTERFACE_H_
+#define KRANG_BALANCING_FAKE_HARDWARE_INTERFACE_H_
+
+#include <somatic.pb-c.h>  // Somatic__WaistMode
+#include <dart/dart.hpp>   // dart::dynamics::SkeletonPtr
+
+#include "hardware_interface.h"  // HardwareInterface
+#include "sensors.h"             // SensorSample
+
+// A robot that exists only in memory. Sensor readings are whatever the owner
+// puts in sensors before each iteration and commands are only stored, so any
+// number of controllers can be run in one process without daemons or channels
+class FakeHardwareInterface : public HardwareInterface {
+ public:
+  // robot is set to the joint positions in sensors on every ReadSensors(). It
+  // may be NULL if the caller keeps the skeleton up to date itself
+  explicit FakeHardwareInterface(dart::dynamics::SkeletonPtr robot);
+  ~FakeHardwareInterface() {}
+
+  void ReadSensors(double dt, SensorSample* sample);
+  void SetWheelCurrents(const double* currents);
+  void HaltArm(Side side);
+  void ResetArm(Side side);
+  void SetArmVelocities(Side side, const double* dq);
+  void SetArmPositions(Side side, const double* q);
+  void SetWaistMode(Somatic__WaistMode mode);
+  void HaltTorso();
+  void ResetTorso();
+  void SetTorsoVelocity(double dq);
+
+  // Readings returned by the next ReadSensors(), including their time
+  SensorSample sensors;
+
+  // Latest commands
+  double wheel_currents[2];
+  bool arm_halted[2];
+  double arm_velocities[2][7];
+  double arm_positions[2][7];
+  Somatic__WaistMode waist_mode;
+  bool torso_halted;
+  double torso_velocity;
+  unsigned long num_commands;  // number of commands of any kind
+
+ private:
+  dart::dynamics::SkeletonPtr robot_;
+};
+
+#endif  // KRANG_BALANCING_FAKE_HARDWARE_INTERFACE_H_
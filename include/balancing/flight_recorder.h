@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file flight_recorder.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for flight_recorder.cpp that keeps the controller state of the
+ * latest iterations in a memory-mapped file
+ */
+
+#ifndef KRANG_BALANCING_FLIGHT_RECORDER_H_
+#define KRANG_BALANCING_FLIGHT_RECORDER_H_
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t, uint64_t, int32_t
+
+#include <vector>  // std::vector
+
+#include "control.h"  // ControlSnapshot, ControlEventState, ControlTuning
+#include "sensors.h"  // SensorSample
+
+// Layout of one iteration in the recording. Only fixed-size types so that the
+// file can be read back by any build on the same architecture. Increment
+// kFlightRecordVersion whenever this layout changes
+const uint32_t kFlightRecordVersion = 10;
+struct FlightRecord {
+  uint64_t tick;              // iteration number since the start of the loop
+  double time;                // time since the start of the loop (s)
+  int32_t started;            // 1 if wheel control was enabled
+  int32_t finger_mode;        // Joystick::FingerButtons
+  int32_t left_mode;          // Joystick::LeftThumb
+  int32_t right_mode;         // Joystick::RightThumb
+  double thumb_value[2];      // joystick thumb values (left, right)
+  ControlSnapshot control;    // controller variables incl. wheel currents
+  SensorSample sensors;       // sensor readings the controller used
+  ControlEventState events;   // controller state after joystick events
+  int32_t events_changed;     // 1 if events or a reload changed the
+                              // controller state in this iteration
+  ControlTuning tuning;       // gains and thresholds of all modes after
+                              // reloads and joystick events
+};
+
+// Header at the beginning of the recording file
+struct FlightRecorderHeader {
+  char magic[8];           // kFlightRecorderMagic
+  uint32_t version;        // kFlightRecordVersion
+  uint32_t record_size;    // sizeof(FlightRecord)
+  uint64_t capacity;       // number of records in the ring
+  uint64_t num_records;    // number of records written since the file was
+                           // created; the oldest one is at index
+                           // num_records % capacity once the ring is full
+  char reserved[32];       // pads the header to 64 bytes
+};
+
+// Keeps the latest iterations of the main loop in a preallocated ring of
+// records in a memory-mapped file. The file is created and prefaulted when it
+// is opened, after which recording an iteration is only plain stores into the
+// mapping: no system calls and no allocation. The kernel writes the pages back
+// to the file on its own, so the recording survives a crash of the process
+// and can be inspected after a fall
+class FlightRecorder {
+ public:
+  FlightRecorder();
+  ~FlightRecorder();
+
+  // Creates the file at path with room for capacity records and maps it. An
+  // existing file is first renamed to <path>.prev, replacing any older one.
+  // Returns false if the file could not be created or mapped
+  bool Open(const char* path, uint64_t capacity);
+
+  // Unmaps the file
+  void Close();
+
+  // Slot in which the next record is to be written. The record is not
+  // visible to readers of the file until Commit() is called
+  FlightRecord* NextRecord() {
+    return &records_[header_->num_records % header_->capacity];
+  }
+
+  // Publishes the record returned by NextRecord()
+  void Commit() {
+    __atomic_store_n(&header_->num_records, header_->num_records + 1,
+                     __ATOMIC_RELEASE);
+  }
+
+  bool is_open() const { return header_ != NULL; }
+
+ private:
+  // Not copyable
+  FlightRecorder(const FlightRecorder&);
+  FlightRecorder& operator=(const FlightRecorder&);
+
+  FlightRecorderHeader* header_;  // start of the mapping
+  FlightRecord* records_;         // ring of records following the header
+  size_t mapping_size_;
+};
+
+// Reads the records of a recording file into records, oldest first. Returns
+// false if the file is missing or is not a recording of this version
+bool ReadFlightRecording(const char* path, std::vector<FlightRecord>* records);
+
+#endif  // KRANG_BALANCING_FLIGHT_RECORDER_H_
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file hardware_interface.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Interface through which the controllers read the sensors of the robot
+ * and command its motors
+ */
+
+#ifndef KRANG_BALANCING_HARDWARE_INTERFACE_H_
+#define KRANG_BALANCING_HARDWARE_INTERFACE_H_
+
+#include <somatic.pb-c.h>  // Somatic__WaistMode
+
+#include "sensors.h"  // SensorSample
+
+// Sensor reads and actuator commands of the robot as used by BalanceControl,
+// ArmControl, ControlWaist() and ControlTorso(). KrangHardwareInterface talks
+// to the motor and sensor daemons; FakeHardwareInterface keeps everything in
+// memory so that the controllers can run without any daemon.
+//
+// The balancing thread calls ReadSensors() and SetWheelCurrents(), and the
+// upper body thread (see upper_body.h) calls the arm, waist and torso
+// methods. Backends used with that thread must allow the upper body methods to
+// run concurrently with ReadSensors() and SetWheelCurrents();
+// KrangHardwareInterface does. Each method is only called from one of the two
+// threads
+class HardwareInterface {
+ public:
+  // Arms are indexed the same way as in Krang::Hardware
+  enum Side { LEFT = 0, RIGHT = 1 };
+
+  virtual ~HardwareInterface() {}
+
+  // Reads all the sensors into sample and updates the pose of the skeleton the
+  // backend was created with. dt is the time step of the current iteration
+  virtual void ReadSensors(double dt, SensorSample* sample) = 0;
+
+  // Commands the currents of the left and right wheels
+  virtual void SetWheelCurrents(const double* currents) = 0;
+
+  // Locks an arm by applying its brakes, and unlocks it for commands
+  virtual void HaltArm(Side side) = 0;
+  virtual void ResetArm(Side side) = 0;
+
+  // Commands the 7 joint velocities or positions of an arm
+  virtual void SetArmVelocities(Side side, const double* dq) = 0;
+  virtual void SetArmPositions(Side side, const double* q) = 0;
+
+  // Sends the mode to the waist daemon
+  virtual void SetWaistMode(Somatic__WaistMode mode) = 0;
+
+  // Locks the torso, unlocks it, and commands its velocity
+  virtual void HaltTorso() = 0;
+  virtual void ResetTorso() = 0;
+  virtual void SetTorsoVelocity(double dq) = 0;
+};
+
+#endif  // KRANG_BALANCING_HARDWARE_INTERFACE_H_
@@ -47,6 +47,10 @@
 #include <somatic.h>
 #include <ach.h>
 
+#include "seqlock.h"
+
+class Logger;
+
 class Joystick {
  public:
   enum FingerButtons {
@@ -104,7 +108,15 @@ class Joystick {
   /// Update joystick state
   bool Update();
 
+  /* ************************************************************************ */
+  /// Update joystick state, waiting up to timeout seconds for a new message
+  bool WaitForUpdate(double timeout);
+
  private:
+  /* ************************************************************************ */
+  // Decodes a message received on the channel with ach status r
+  bool Decode(Somatic__Joystick* js_msg, int r);
+
   /* ************************************************************************ */
   // Opens ach channel to read joystick data
   void OpenJoystickChannel();
@@ -116,4 +128,44 @@ class Joystick {
 
   ach_channel_t ach_chan;				///< Read joystick data on this channel
 };
+
+/* ************************************************************************** */
+/// The decoded joystick input as used by the control loop
+struct JoystickState {
+  JoystickState();
+
+  Joystick::FingerButtons fingerMode;
+  Joystick::RightThumb rightMode;
+  Joystick::LeftThumb leftMode;
+  double thumbValue[2];
+  double receive_time;  // CLOCK_MONOTONIC time (s) the message was received
+};
+
+/* ************************************************************************** */
+/// Info shared between the joystick thread and the control loop
+struct JoystickShared {
+  JoystickShared(double timeout_ms = 0.0)
+      : last_version(0), timeout(timeout_ms * 1e-3), timed_out(false) {}
+
+  SeqLock<JoystickState> state;  // written only by the joystick thread
+  unsigned long last_version;    // version of state last read by the loop
+  double timeout;   // (s) input is dropped after this long without a message
+  bool timed_out;   // input has been dropped since the last message
+};
+
+// Thread that waits on the joystick channel and publishes every decoded message
+// in JoystickShared::state
+void* JoystickThread(void*);
+
+// For the control loop to read the latest joystick input without waiting.
+// Returns true if a new message was decoded since the last call. Otherwise the
+// previous input is kept with press/release events turned into hold/free, so
+// that an event is not triggered again on every iteration of the loop. If no
+// message has arrived for longer than JoystickShared::timeout (when positive),
+// the thumb values are zeroed and all modes are set to free, as if the
+// joystick had been let go. The timeout and the recovery from it are reported
+// through logger, if given, so that the control loop never prints itself
+bool ReadJoystickState(JoystickShared& js_shared, JoystickState* state,
+                       Logger* logger = NULL);
+
 #endif // KRANG_BALANCING_JOYSTICK_H_
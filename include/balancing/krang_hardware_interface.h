@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file krang_hardware_interface.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for krang_hardware_interface.cpp that implements the hardware
+ * interface on top of Krang::Hardware and the somatic daemons
+ */
+
+#ifndef KRANG_BALANCING_KRANG_HARDWARE_INTERFACE_H_
+#define KRANG_BALANCING_KRANG_HARDWARE_INTERFACE_H_
+
+#include <ach.h>
+#include <somatic.h>
+#include <somatic/daemon.h>
+#include <somatic/motor.h>
+#include <kore.hpp>
+
+#include "hardware_interface.h"  // HardwareInterface
+#include "sensors.h"             // SensorSample
+
+// The real robot (or the krang-sim-ach simulation) behind the motor and sensor
+// daemons. Samples are stamped with the time of the latest AMC state message.
+// Neither the daemon context nor the hardware are owned, and only
+// ReadSensors() and SetWheelCurrents() use them. The arm, waist and torso
+// commands go through a daemon context and motor handles of their own, so
+// that they can be sent from another thread without any lock
+class KrangHardwareInterface : public HardwareInterface {
+ public:
+  KrangHardwareInterface(somatic_d_t* daemon_cx, Krang::Hardware* krang);
+  ~KrangHardwareInterface();
+
+  void ReadSensors(double dt, SensorSample* sample);
+  void SetWheelCurrents(const double* currents);
+  void HaltArm(Side side);
+  void ResetArm(Side side);
+  void SetArmVelocities(Side side, const double* dq);
+  void SetArmPositions(Side side, const double* q);
+  void SetWaistMode(Somatic__WaistMode mode);
+  void HaltTorso();
+  void ResetTorso();
+  void SetTorsoVelocity(double dq);
+
+ private:
+  // Not copyable, since the upper body context, motor handles and waist
+  // command are freed on destruction
+  KrangHardwareInterface(const KrangHardwareInterface&);
+  KrangHardwareInterface& operator=(const KrangHardwareInterface&);
+
+  // Balancing thread
+  somatic_d_t* daemon_cx_;
+  Krang::Hardware* krang_;
+  ach_channel_t amc_state_chan_;  // read for the timestamps of the wheels
+  double sensor_time_;            // of the latest AMC message (s)
+
+  // Upper body thread
+  somatic_d_t upper_body_cx_;
+  somatic_motor_t arms_[2];       // command the arms, indexed by Side
+  somatic_motor_t torso_;         // commands the torso
+  Somatic__WaistCmd* waist_cmd_;  // message reused for every waist command
+};
+
+#endif  // KRANG_BALANCING_KRANG_HARDWARE_INTERFACE_H_
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file logger.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for logger.cpp that prints the state of the main loop from a
+ * separate thread
+ */
+
+#ifndef KRANG_BALANCING_LOGGER_H_
+#define KRANG_BALANCING_LOGGER_H_
+
+#include <pthread.h>  // pthread_t
+#include <stddef.h>   // size_t
+
+#include <atomic>  // std::atomic
+
+#include "control.h"     // ControlSnapshot
+#include "spsc_ring.h"   // SpscRing
+
+class TickProfiler;
+
+// Compact record of one iteration of the main loop that is printed by the
+// logger thread
+struct LogRecord {
+  double time;                  // time since the start of the main loop (s)
+  int is_simulation;            // 1 if interfacing with simulation
+  int started;                  // 1 if wheel control is enabled
+  int loop_timer_enabled;       // 1 if the loop runs at a fixed rate
+  long num_overruns;            // overruns of the loop timer so far
+  long num_missed_deadlines;    // deadlines missed by the loop timer so far
+  ControlSnapshot control;      // variables of the balancing controller
+};
+
+// Dump a record on the screen
+void PrintLogRecord(const LogRecord& record);
+
+// Line of text from the control thread, e.g. a warning, printed as is by the
+// logger thread
+struct LogMessage {
+  char text[128];
+};
+
+// Moves formatting and terminal output off the control thread. The control
+// thread copies a LogRecord into a preallocated ring and a low-priority thread
+// pops and prints it. If the ring is full the record is dropped and counted
+// rather than making the control thread wait
+class Logger {
+ public:
+  // capacity: number of records that can be queued, must be a power of two
+  explicit Logger(size_t capacity);
+  ~Logger();
+
+  // Starts the printing thread
+  void Start();
+
+  // Prints whatever is still queued and stops the printing thread
+  void Stop();
+
+  // Called by the control thread. Returns false if the record was dropped
+  bool Log(const LogRecord& record);
+
+  // Called by the control thread. Formats a line like printf() into a queued
+  // message. Returns false if the message was dropped
+  bool Message(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+  // Called by the control thread. Copies the histograms of profiler for the
+  // logger thread to print. Returns false if the previous copy has not been
+  // printed yet
+  bool DumpProfile(const TickProfiler& profiler);
+
+  unsigned long num_dropped() const { return num_dropped_.load(); }
+  unsigned long num_dropped_messages() const {
+    return num_dropped_messages_.load();
+  }
+
+ private:
+  // Body of the printing thread
+  static void* Run(void* arg);
+
+  SpscRing<LogRecord> ring_;
+  SpscRing<LogMessage> messages_;
+  std::atomic<unsigned long> num_dropped_;
+  std::atomic<unsigned long> num_dropped_messages_;
+  TickProfiler* profile_;               // copy waiting to be printed
+  std::atomic<bool> profile_pending_;   // profile_ is complete and unprinted
+  std::atomic<bool> running_;
+  pthread_t thread_;
+};
+
+#endif  // KRANG_BALANCING_LOGGER_H_
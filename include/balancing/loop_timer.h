@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file loop_timer.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for loop_timer.cpp that runs the control loop at a fixed rate
+ */
+
+#ifndef KRANG_BALANCING_LOOP_TIMER_H_
+#define KRANG_BALANCING_LOOP_TIMER_H_
+
+#include <time.h>  // struct timespec
+
+// Periodic executor for the main loop. Sleeps on absolute deadlines using
+// clock_nanosleep() on CLOCK_MONOTONIC so that the period does not drift with
+// the time spent inside the loop body, and keeps track of deadlines that were
+// missed because the loop body took longer than a period
+class LoopTimer {
+ public:
+  // rate: target loop rate in Hz. A non-positive rate disables the timer, in
+  // which case Wait() returns immediately and the loop runs free
+  explicit LoopTimer(double rate);
+  ~LoopTimer() {}
+
+  // Sets the first deadline one period from now
+  void Start();
+
+  // Sleeps until the next deadline. If the deadline has already passed, the
+  // tick is counted as an overrun and the deadline is moved forward by the
+  // number of whole periods missed instead of trying to catch up on them.
+  // Returns the number of periods since the previous deadline (1 when the
+  // deadline was met)
+  int Wait();
+
+  // Dump the deadline statistics on the screen
+  void PrintStats() const;
+
+  // Getters
+  bool enabled() const { return period_ns_ > 0; }
+  double period() const { return period_ns_ * 1e-9; }
+  long num_ticks() const { return num_ticks_; }
+  long num_overruns() const { return num_overruns_; }
+  long num_missed_deadlines() const { return num_missed_deadlines_; }
+  double max_lateness() const { return max_lateness_ns_ * 1e-9; }
+
+ private:
+  long period_ns_;              // loop period in nanoseconds
+  struct timespec deadline_;    // absolute time of the next deadline
+  long num_ticks_;              // number of calls to Wait()
+  long num_overruns_;           // ticks that started after their deadline
+  long num_missed_deadlines_;   // total deadlines skipped because of overruns
+  long max_lateness_ns_;        // worst observed lateness w.r.t. a deadline
+};
+
+#endif  // KRANG_BALANCING_LOOP_TIMER_H_
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file lqr_gain_cache.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for lqr_gain_cache.cpp that keeps the LQR gains of recently
+ * seen upper body poses
+ */
+
+#ifndef KRANG_BALANCING_LQR_GAIN_CACHE_H_
+#define KRANG_BALANCING_LQR_GAIN_CACHE_H_
+
+#include <stdint.h>  // int32_t, uint64_t
+
+#include <vector>  // std::vector
+
+#include <Eigen/Eigen>  // Eigen::Matrix<double, #, #>
+
+// Least recently used cache of lqr gains keyed on the upper body pose: waist,
+// torso and both arms, each position rounded to a multiple of a quantum. All
+// memory is allocated in the constructor; a lookup is a hash of the key and a
+// walk of a short chain, and a full cache evicts the entry used least
+// recently
+class LqrGainCache {
+ public:
+  // Positions in a pose: waist, torso, 7 left arm and 7 right arm joints
+  static const int kPoseSize = 16;
+
+  struct Key {
+    int32_t q[kPoseSize];
+  };
+
+  // capacity: number of poses kept, at least 1
+  // quantum: rounding step of the positions (rad)
+  LqrGainCache(int capacity, double quantum);
+  ~LqrGainCache() {}
+
+  // Rounds the kPoseSize positions of pose into a key
+  void MakeKey(const double* pose, Key* key) const;
+
+  // Copies the gains of key and marks it as the most recently used. Returns
+  // false if key is not cached
+  bool Lookup(const Key& key, Eigen::Matrix<double, 4, 1>* gains);
+
+  // Adds the gains of key, which must not be cached, evicting the least
+  // recently used entry if the cache is full
+  void Insert(const Key& key, const Eigen::Matrix<double, 4, 1>& gains);
+
+  // Forgets all entries, e.g. when the lqr costs change. Keeps the memory and
+  // the hit and miss counts
+  void Clear();
+
+  // Getters
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  int size() const { return size_; }
+  int capacity() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    Key key;
+    double gains[4];
+    int next_in_bucket;  // chain of entries with the same hash, -1 ends it
+    int newer, older;    // recency list, -1 ends it
+  };
+
+  static uint64_t Hash(const Key& key);
+  static bool Equal(const Key& a, const Key& b);
+  int Bucket(const Key& key) const { return Hash(key) & (buckets_.size() - 1); }
+
+  // Recency list
+  void Unlink(int index);
+  void PushNewest(int index);
+
+  // Removes an entry from its bucket
+  void RemoveFromBucket(int index);
+
+  double quantum_;
+  std::vector<Entry> entries_;
+  std::vector<int> buckets_;  // first entry of each chain, a power of 2
+  int size_;                  // entries in use
+  int newest_, oldest_;       // ends of the recency list
+  uint64_t hits_, misses_;
+};
+
+#endif  // KRANG_BALANCING_LQR_GAIN_CACHE_H_
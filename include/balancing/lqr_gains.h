@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file lqr_gains.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for lqr_gains.cpp that computes the pose-dependent LQR gains
+ * of the balancing controller, online or from a precomputed table
+ */
+
+#ifndef KRANG_BALANCING_LQR_GAINS_H_
+#define KRANG_BALANCING_LQR_GAINS_H_
+
+#include <stdint.h>  // uint32_t, uint64_t
+
+#include <vector>  // std::vector
+
+#include <Eigen/Eigen>    // Eigen::Matrix<double, #, #>
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr
+#include <krang-utils/linearize_wip.hpp>  // linearize_wip::ParametersNotFoundInUrdf
+
+#include "riccati.h"  // RiccatiSolver
+
+// Rotor inertia, gear ratio and wheel radius of the robot or the simulation
+linearize_wip::ParametersNotFoundInUrdf WipMotorParameters(bool is_simulation);
+
+// Lumped parameters of the wheeled inverted pendulum. The body is everything
+// but the wheels, and the pendulum angle theta is that of its com about the
+// wheel axle
+struct WipParameters {
+  double body_mass;      // (kg)
+  double com_distance;   // from the wheel axle to the body com (m)
+  double body_inertia;   // of the body about the wheel axle (kg m^2)
+  double wheel_mass;     // of both wheels (kg)
+  double wheel_inertia;  // of both wheels about the axle (kg m^2)
+  linearize_wip::ParametersNotFoundInUrdf motor;
+};
+
+// Linearizes the wheeled inverted pendulum at the current pose of robot.
+// A (4x4) and B (4x1) are the dynamics of theta, dtheta, x and dx under the
+// wheel torque
+void LinearizeWip(dart::dynamics::SkeletonPtr robot, bool is_simulation,
+                  Eigen::MatrixXd* A, Eigen::MatrixXd* B);
+
+// The same linearization in closed form from the lumped parameters, about
+// the upright pose. x is the wheel angle and the torque acts between the body
+// and the wheels
+void LinearizeWip(const WipParameters& wip, Eigen::Matrix<double, 4, 4>* A,
+                  Eigen::Matrix<double, 4, 1>* B);
+
+// Solves the LQR problem of the linearized dynamics A and B with costs Q and
+// R, as ComputeLqrGains() does after the linearization
+void SolveLqrGains(const Eigen::Matrix<double, 4, 4>& A,
+                   const Eigen::Matrix<double, 4, 1>& B,
+                   const Eigen::Matrix<double, 4, 4>& Q,
+                   const Eigen::Matrix<double, 1, 1>& R,
+                   Eigen::Matrix<double, 4, 1>* gains,
+                   RiccatiSolver<4, 1>* solver = NULL);
+
+// Linearizes the wheeled inverted pendulum at the current pose of robot and
+// solves the LQR problem with costs Q and R. gains are the currents for theta,
+// dtheta, x and dx, before any hardware specific correction. If solver is
+// given, the Riccati equation is solved with it, warm-started from its
+// previous call, and lqr() of krang-utils is only used if it fails. Allocates
+// on the heap in the linearization
+void ComputeLqrGains(dart::dynamics::SkeletonPtr robot, bool is_simulation,
+                     const Eigen::Matrix<double, 4, 4>& Q,
+                     const Eigen::Matrix<double, 1, 1>& R,
+                     Eigen::Matrix<double, 4, 1>* gains,
+                     RiccatiSolver<4, 1>* solver = NULL);
+
+// Header of a gain table file, followed by the gains as doubles with the
+// torso index varying fastest. Increment kLqrGainTableVersion whenever this
+// layout changes
+const uint32_t kLqrGainTableVersion = 2;
+struct LqrGainTableHeader {
+  char magic[8];             // kLqrGainTableMagic
+  uint32_t version;          // kLqrGainTableVersion
+  uint32_t is_simulation;    // gains are scaled differently for simulation
+  uint32_t num_waist;        // grid points along the waist angle
+  uint32_t num_torso;        // grid points along the torso angle
+  double waist_min, waist_max;  // range of the waist angle (rad)
+  double torso_min, torso_max;  // range of the torso angle (rad)
+  double lqr_q[4];           // diagonal of Q the gains were computed with
+  double lqr_r;              // R the gains were computed with
+  double arm_pose[14];       // left and right arm joints during the sweep
+  uint32_t arm_preset;       // ArmControl preset arm_pose was taken from
+  uint32_t padding;
+  uint64_t com_parameters_hash;  // HashComParameters() of the CoM parameters
+};
+
+// Hash of the CoM parameters (beta) applied to the robot, so that a table can
+// be told apart from one computed with other parameters. An empty beta stands
+// for the masses of the urdf
+uint64_t HashComParameters(const Eigen::MatrixXd& beta);
+
+// LQR gains on a grid of waist and torso angles, with the arms held in one
+// pose. The gains for the current pose are interpolated bilinearly from the
+// four surrounding grid points, so a lookup costs the same at any pose. Poses
+// outside the grid use the gains at its edge
+class LqrGainTable {
+ public:
+  LqrGainTable();
+
+  // Allocates a table for the grid described by header, with all gains zero
+  void Create(const LqrGainTableHeader& header);
+
+  // Reads and writes table files. Return false if the file could not be read
+  // or written or is not a valid table
+  bool Load(const char* path);
+  bool Save(const char* path) const;
+
+  // Grid angles for the indices i and j
+  double waist(int i) const;
+  double torso(int j) const;
+
+  void Set(int i, int j, const Eigen::Matrix<double, 4, 1>& gains);
+
+  // Interpolated gains at the given angles. Only valid for a table that has
+  // been created or loaded
+  void Lookup(double waist, double torso,
+              Eigen::Matrix<double, 4, 1>* gains) const;
+
+  // True if the table was computed for the given mode, LQR costs and CoM
+  // parameters (see HashComParameters()). Prints what differs otherwise
+  bool Matches(bool is_simulation, const Eigen::Matrix<double, 4, 4>& Q,
+               const Eigen::Matrix<double, 1, 1>& R,
+               uint64_t com_parameters_hash) const;
+
+  // True if no joint of the arms (7 of the left one, then 7 of the right one)
+  // is farther than tolerance (rad) from the pose the table was computed for
+  bool ArmsAtPose(const double* arm_pose, double tolerance) const;
+
+  bool empty() const { return gains_.empty(); }
+  const LqrGainTableHeader& header() const { return header_; }
+
+ private:
+  LqrGainTableHeader header_;
+  std::vector<double> gains_;  // 4 per grid point
+};
+
+#endif  // KRANG_BALANCING_LQR_GAINS_H_
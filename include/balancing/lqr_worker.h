@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file lqr_worker.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for lqr_worker.cpp that solves the dynamic LQR gains on a
+ * separate thread
+ */
+
+#ifndef KRANG_BALANCING_LQR_WORKER_H_
+#define KRANG_BALANCING_LQR_WORKER_H_
+
+#include <pthread.h>  // pthread_t
+#include <time.h>     // struct timespec
+
+#include <atomic>  // std::atomic
+
+#include <Eigen/Eigen>    // Eigen::Matrix<double, #, #>
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr
+
+#include "riccati.h"  // RiccatiSolver
+#include "sensors.h"  // kMaxSensorDofs
+#include "seqlock.h"  // SeqLock
+
+// Keeps solving the LQR gains for the latest pose of the robot on a
+// low-priority thread, so that the cost of the solver never shows up in the
+// control loop. The control thread publishes the joint positions every
+// iteration and picks up the newest gains; neither side ever waits for the
+// other
+class LqrWorker {
+ public:
+  // The worker solves on its own copy of robot, with the same arguments as
+  // ComputeLqrGains()
+  LqrWorker(dart::dynamics::SkeletonPtr robot, bool is_simulation,
+            const Eigen::Matrix<double, 4, 4>& Q,
+            const Eigen::Matrix<double, 1, 1>& R);
+  ~LqrWorker();
+
+  void Start();
+  void Stop();
+
+  // Called by the control thread with the joint positions of the skeleton
+  void PublishPose(const double* q, int num_dofs);
+
+  // Called by the control thread. Copies the newest gains and their age, i.e.
+  // the seconds since the pose they were solved for was published. Returns
+  // false if no gains have been solved yet with the current costs
+  bool LatestGains(Eigen::Matrix<double, 4, 1>* gains, double* age);
+
+  // Called by the control thread. Poses published from now on are solved
+  // with these costs, and gains solved with the previous ones are dropped
+  void SetCosts(const Eigen::Matrix<double, 4, 4>& Q,
+                const Eigen::Matrix<double, 1, 1>& R);
+
+  unsigned long num_solves() const { return gains_.version(); }
+
+ private:
+  struct Pose {
+    struct timespec time;  // when the pose was published
+    int num_dofs;
+    double q[kMaxSensorDofs];
+    double lqr_q[4], lqr_r;     // costs to solve with: diagonal of Q, and R
+    unsigned long costs_version;  // times the costs were set before
+  };
+  struct Gains {
+    struct timespec pose_time;  // time of the pose the gains are for
+    double gains[4];
+    unsigned long costs_version;  // of the costs they were solved with
+  };
+
+  // Not copyable
+  LqrWorker(const LqrWorker&);
+  LqrWorker& operator=(const LqrWorker&);
+
+  // Body of the solver thread
+  static void* Run(void* arg);
+
+  dart::dynamics::SkeletonPtr robot_;  // copy owned by the solver thread
+  bool is_simulation_;
+  Eigen::Matrix<double, 4, 4> Q_;  // costs of the control thread, sent to
+  Eigen::Matrix<double, 1, 1> R_;  // the solver with every pose
+  unsigned long costs_version_;    // control thread only
+  RiccatiSolver<4, 1> riccati_;  // warm-started from the previous pose
+
+  SeqLock<Pose> pose_;    // written by the control thread
+  SeqLock<Gains> gains_;  // written by the solver thread
+  Gains latest_;          // last consistent read, control thread only
+  bool has_gains_;        // control thread only
+
+  std::atomic<bool> running_;
+  pthread_t thread_;
+};
+
+#endif  // KRANG_BALANCING_LQR_WORKER_H_
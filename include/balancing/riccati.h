@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file riccati.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Fixed-size solver of the continuous algebraic Riccati equation that
+ * is warm-started from its previous solution
+ */
+
+#ifndef KRANG_BALANCING_RICCATI_H_
+#define KRANG_BALANCING_RICCATI_H_
+
+#include <Eigen/Eigen>  // Eigen::Matrix<double, #, #>, Eigen::FullPivLU, ...
+
+// Solves the continuous algebraic Riccati equation
+//   A'P + PA - PBR^-1B'P + Q = 0
+// of an N-state, M-input system for the stabilizing P and the lqr gain
+// K = R^-1B'P of u = -Kx, with matrices of fixed size only (nothing is
+// allocated on the heap).
+//
+// The solution is refined with Newton-Kleinman iterations, each of which
+// solves a Lyapunov equation for the closed loop of the current gain. When
+// the system changes little between calls, as the linearized dynamics of the
+// robot between two iterations of the control loop, the gain of the previous
+// call still stabilizes the system and one or two iterations are enough.
+// Otherwise, e.g. on the first call, the iterations start from a gain found
+// with the matrix sign function of the Hamiltonian of the equation.
+//
+// Q must be positive definite and R symmetric positive definite
+template <int N, int M>
+class RiccatiSolver {
+ public:
+  typedef Eigen::Matrix<double, N, N> MatrixNN;
+  typedef Eigen::Matrix<double, N, M> MatrixNM;
+  typedef Eigen::Matrix<double, M, M> MatrixMM;
+  typedef Eigen::Matrix<double, M, N> MatrixMN;
+
+  // tolerance: iterations stop once the gain changes by less than this
+  // fraction of its norm
+  // max_iterations: limit of the Newton-Kleinman and sign function iterations
+  explicit RiccatiSolver(double tolerance = 1e-12, int max_iterations = 50)
+      : tolerance_(tolerance),
+        max_iterations_(max_iterations),
+        has_solution_(false),
+        iterations_(0),
+        warm_started_(false) {}
+  ~RiccatiSolver() {}
+
+  // Solves for the gain K. Returns false if no stabilizing solution was found,
+  // in which case K is left unchanged and the next call starts from scratch
+  bool Solve(const MatrixNN& A, const MatrixNM& B, const MatrixNN& Q,
+             const MatrixMM& R, MatrixMN* K) {
+    MatrixMN R_inv_Bt = R.ldlt().solve(B.transpose());
+    iterations_ = 0;
+
+    // The previous gain, if the closed loop it gives is still stable
+    warm_started_ = has_solution_;
+    if (!has_solution_ || !NewtonKleinman(A, B, Q, R, R_inv_Bt)) {
+      warm_started_ = false;
+      has_solution_ = (SignFunction(A, B, Q, R_inv_Bt) &&
+                       NewtonKleinman(A, B, Q, R, R_inv_Bt));
+    }
+    if (has_solution_) *K = K_;
+    return has_solution_;
+  }
+
+  // Forgets the previous solution so that the next call starts from scratch
+  void Reset() { has_solution_ = false; }
+
+  // Getters. Refer to the latest call to Solve()
+  const MatrixNN& P() const { return P_; }
+  int iterations() const { return iterations_; }
+  bool warm_started() const { return warm_started_; }
+
+ private:
+  typedef Eigen::Matrix<double, N * N, N * N> MatrixN2N2;
+  typedef Eigen::Matrix<double, N * N, 1> VectorN2;
+  typedef Eigen::Matrix<double, 2 * N, 2 * N> Matrix2N2N;
+  typedef Eigen::Matrix<double, 2 * N, N> Matrix2NN;
+
+  // Solves A_cl'P + PA_cl + C = 0 for P. Returns false if it has no unique
+  // solution
+  static bool SolveLyapunov(const MatrixNN& A_cl, const MatrixNN& C,
+                            MatrixNN* P) {
+    // In terms of the columns of P stacked into a vector:
+    // (I x A_cl' + A_cl' x I) vec(P) = -vec(C), with x the Kronecker product
+    MatrixN2N2 L = MatrixN2N2::Zero();
+    for (int i = 0; i < N; i++) {
+      L.template block<N, N>(N * i, N * i) += A_cl.transpose();
+      for (int j = 0; j < N; j++) {
+        L.template block<N, N>(N * i, N * j) +=
+            A_cl(j, i) * MatrixNN::Identity();
+      }
+    }
+    Eigen::FullPivLU<MatrixN2N2> lu(L);
+    if (!lu.isInvertible()) return false;
+    VectorN2 c;
+    for (int j = 0; j < N; j++) c.template segment<N>(N * j) = -C.col(j);
+    VectorN2 p = lu.solve(c);
+    for (int j = 0; j < N; j++) P->col(j) = p.template segment<N>(N * j);
+    *P = 0.5 * (*P + P->transpose());
+    return true;
+  }
+
+  // Newton-Kleinman iterations starting from the gain K_. Returns false if K_
+  // does not stabilize A - BK_ or the iterations do not converge
+  bool NewtonKleinman(const MatrixNN& A, const MatrixNM& B, const MatrixNN& Q,
+                      const MatrixMM& R, const MatrixMN& R_inv_Bt) {
+    double last_change = 0.0;
+    for (int i = 0; i < max_iterations_; i++) {
+      iterations_++;
+      MatrixNN A_cl = A - B * K_;
+      MatrixNN C = Q + K_.transpose() * R * K_;
+      if (!SolveLyapunov(A_cl, C, &P_)) return false;
+
+      // With C positive definite, P is positive definite if and only if A_cl
+      // is stable
+      if (P_.llt().info() != Eigen::Success) return false;
+
+      MatrixMN K = R_inv_Bt * P_;
+      double change = (K - K_).norm();
+      K_ = K;
+      if (change <= tolerance_ * K_.norm()) return true;
+
+      // In badly conditioned problems rounding errors may keep the changes
+      // above the tolerance. Stop once they no longer shrink
+      if (i > 0 && change >= last_change && change <= 1e-6 * K_.norm())
+        return true;
+      last_change = change;
+    }
+    return false;
+  }
+
+  // Sets K_ to the gain of the stable invariant subspace of the Hamiltonian
+  // H = [A, -BR^-1B'; -Q, -A'], found with the Newton iteration of the matrix
+  // sign function. Returns false if the iteration fails
+  bool SignFunction(const MatrixNN& A, const MatrixNM& B, const MatrixNN& Q,
+                    const MatrixMN& R_inv_Bt) {
+    Matrix2N2N Z;
+    Z.template block<N, N>(0, 0) = A;
+    Z.template block<N, N>(0, N) = -B * R_inv_Bt;
+    Z.template block<N, N>(N, 0) = -Q;
+    Z.template block<N, N>(N, N) = -A.transpose();
+
+    // Z <- (Z / c + c Z^-1) / 2 with the determinant scaling c = |det Z|^(1/2N)
+    bool converged = false;
+    for (int i = 0; i < max_iterations_ && !converged; i++) {
+      iterations_++;
+      Eigen::PartialPivLU<Matrix2N2N> lu(Z);
+      double det = fabs(lu.determinant());
+      if (!(det > 0.0)) return false;
+      double c = pow(det, 1.0 / (2 * N));
+      Matrix2N2N Z_next = 0.5 * (Z / c + c * lu.inverse());
+      double change = (Z_next - Z).template lpNorm<1>();
+      Z = Z_next;
+      converged = (change <= 1e3 * tolerance_ * Z.template lpNorm<1>());
+    }
+    if (!converged) return false;
+
+    // With W = sign(H), (W + I)[I; P] = 0
+    Matrix2NN lhs, rhs;
+    lhs.template block<N, N>(0, 0) = Z.template block<N, N>(0, N);
+    lhs.template block<N, N>(N, 0) =
+        Z.template block<N, N>(N, N) + MatrixNN::Identity();
+    rhs.template block<N, N>(0, 0) =
+        -Z.template block<N, N>(0, 0) - MatrixNN::Identity();
+    rhs.template block<N, N>(N, 0) = -Z.template block<N, N>(N, 0);
+    // Least squares through the normal equations, which keep the sizes fixed
+    P_ = (lhs.transpose() * lhs).ldlt().solve(lhs.transpose() * rhs);
+    P_ = 0.5 * (P_ + P_.transpose());
+    K_ = R_inv_Bt * P_;
+    return true;
+  }
+
+  double tolerance_;
+  int max_iterations_;
+  bool has_solution_;  // K_ and P_ hold the solution of the previous call
+  int iterations_;     // sign function and Newton iterations of the last call
+  bool warm_started_;  // the last call started from the previous solution
+  MatrixNN P_;
+  MatrixMN K_;
+};
+
+#endif  // KRANG_BALANCING_RICCATI_H_
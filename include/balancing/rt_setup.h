@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file rt_setup.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for rt_setup.cpp that prepares the process and the main loop
+ * for real-time execution
+ */
+
+#ifndef KRANG_BALANCING_RT_SETUP_H_
+#define KRANG_BALANCING_RT_SETUP_H_
+
+#include "balancing_config.h"  // BalancingConfig
+
+// Locks the memory of the process and prefaults rtPrefaultHeapKb of heap,
+// which malloc keeps afterwards instead of giving it back to the system. Also
+// moves the calling thread to rtAuxiliaryCpus, so that threads created
+// afterwards start there. Call before any other thread is created. Prints
+// what succeeded and returns false if anything failed
+bool SetupRtProcess(const BalancingConfig& params);
+
+// Moves the calling thread to rtControlCpus with SCHED_FIFO at rtPriority and
+// prefaults rtPrefaultStackKb of its stack. Call from the main loop thread
+// once the other threads have been created. Prints what succeeded and returns
+// false if anything failed
+bool SetupRtControlThread(const BalancingConfig& params);
+
+#endif  // KRANG_BALANCING_RT_SETUP_H_
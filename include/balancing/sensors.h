@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file sensors.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Sensor readings used by the balancing controller in one iteration
+ */
+
+#ifndef KRANG_BALANCING_SENSORS_H_
+#define KRANG_BALANCING_SENSORS_H_
+
+// Indices of the dofs in Krang's skeleton, i.e. in SensorSample::q
+const int kLWheelDof = 6;
+const int kRWheelDof = 7;
+const int kWaistDof = 8;
+const int kTorsoDof = 9;
+const int kArmDof[2] = {11, 18};  // first joint of the left and right arms
+
+// Largest number of degrees of freedom of the skeleton that a SensorSample
+// can hold
+const int kMaxSensorDofs = 32;
+
+// Everything the balancing controller reads from the robot in one iteration,
+// stored as plain arrays so that it can be recorded and played back as is
+struct SensorSample {
+  double imu;          // base angle measured by the imu (rad)
+  double imu_speed;    // base angular speed measured by the imu (rad/s)
+  double amc_pos[2];   // left and right wheel positions (rad)
+  double amc_vel[2];   // left and right wheel velocities (rad/s)
+  double waist_pos[2]; // positions of the two waist motors (rad)
+  double time;         // when the readings were taken (s), on the clock of
+                       // the backend
+  int num_dofs;        // number of elements of q in use
+  int reserved;        // keeps q 8-byte aligned
+  double q[kMaxSensorDofs];  // joint positions of the skeleton as updated from
+                             // the sensors
+};
+
+#endif  // KRANG_BALANCING_SENSORS_H_
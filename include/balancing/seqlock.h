@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file seqlock.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Single-writer sequence lock used to hand data between threads
+ * without blocking the reader
+ */
+
+#ifndef KRANG_BALANCING_SEQLOCK_H_
+#define KRANG_BALANCING_SEQLOCK_H_
+
+#include <stddef.h>  // NULL
+
+#include <atomic>  // std::atomic, std::atomic_thread_fence
+
+// Holds the latest value of T published by a single writer thread. The writer
+// never waits and the readers never block the writer: a reader copies the
+// value and then checks through the sequence number that no write happened
+// during the copy. T should be a plain data type that can be copied with an
+// assignment (no pointers to memory owned by the writer)
+template <typename T>
+class SeqLock {
+ public:
+  SeqLock() : sequence_(0) {}
+  explicit SeqLock(const T& value) : sequence_(0), value_(value) {}
+  ~SeqLock() {}
+
+  // Publishes a new value. Must only be called from one thread
+  void Store(const T& value) {
+    unsigned long sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    value_ = value;
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Copies the latest value into value. Returns false, leaving value in an
+  // unspecified state, if the writer was publishing during the copy. On
+  // success version (if not NULL) is set to the number of values published so
+  // far
+  bool TryLoad(T* value, unsigned long* version = NULL) const {
+    unsigned long sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1) return false;
+    *value = value_;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != sequence) return false;
+    if (version != NULL) *version = sequence / 2;
+    return true;
+  }
+
+  // Copies the latest value into value, retrying until the copy is
+  // consistent. Returns the version of the value read
+  unsigned long Load(T* value) const {
+    unsigned long version;
+    while (!TryLoad(value, &version)) {
+    }
+    return version;
+  }
+
+  // Number of values published so far
+  unsigned long version() const {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  std::atomic<unsigned long> sequence_;  // odd while a write is in progress
+  T value_;
+};
+
+#endif  // KRANG_BALANCING_SEQLOCK_H_
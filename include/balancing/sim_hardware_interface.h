@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file sim_hardware_interface.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for sim_hardware_interface.cpp that simulates the robot inside
+ * the balancing process
+ */
+
+#ifndef KRANG_BALANCING_SIM_HARDWARE_INTERFACE_H_
+#define KRANG_BALANCING_SIM_HARDWARE_INTERFACE_H_
+
+#include <somatic.pb-c.h>              // Somatic__WaistMode
+#include <dart/dart.hpp>               // dart::dynamics::SkeletonPtr
+#include <krang-sim-ach/dart_world.h>  // KrangInitPoseParams
+
+#include "hardware_interface.h"  // HardwareInterface
+#include "sensors.h"             // SensorSample
+
+// A plant stepped in lockstep with the controller in the same process, instead
+// of the krang-sim-ach process behind ach channels. Pitch and forward motion
+// follow the planar wheeled inverted pendulum and spin a yaw model driven by
+// the wheel torque difference, with the mass properties taken from the plant
+// skeleton in its current pose. When the pitch reaches the resting angle the
+// body is supported by the ground and only rolls. Waist, torso and arms follow
+// their commands kinematically. Heading is not applied to the skeleton; it
+// only shows in the wheel positions
+class SimHardwareInterface : public HardwareInterface {
+ public:
+  // robot: skeleton of the controller, set to the plant pose on ReadSensors()
+  // plant: skeleton that is simulated, separate from robot
+  // pose: initial pose as in the simulation cfg. The plant starts at rest on
+  // the ground at pose.q_base_init
+  SimHardwareInterface(
+      dart::dynamics::SkeletonPtr robot, dart::dynamics::SkeletonPtr plant,
+      const krang_sim_ach::dart_world::KrangInitPoseParams& pose);
+  ~SimHardwareInterface() {}
+
+  // Advances the plant by dt seconds under the latest commands
+  void Step(double dt);
+
+  void ReadSensors(double dt, SensorSample* sample);
+  void SetWheelCurrents(const double* currents);
+  void HaltArm(Side side);
+  void ResetArm(Side side);
+  void SetArmVelocities(Side side, const double* dq);
+  void SetArmPositions(Side side, const double* q);
+  void SetWaistMode(Somatic__WaistMode mode);
+  void HaltTorso();
+  void ResetTorso();
+  void SetTorsoVelocity(double dq);
+
+ private:
+  // Moves the upper body joints according to their commands
+  void StepUpperBody(double dt);
+
+  // Sets the plant skeleton to the simulated state
+  void UpdatePlantPose(double pitch_change, double forward_change);
+
+  enum ArmMode { kHalted, kVelocity, kPosition };
+
+  dart::dynamics::SkeletonPtr robot_;
+  dart::dynamics::SkeletonPtr plant_;
+  dart::dynamics::BodyNodePtr lwheel_, rwheel_;
+
+  // Simulated state
+  double imu_, imu_speed_;        // base pitch and its rate
+  double wheel_, wheel_speed_;    // mean wheel angle in the world and rate
+  double spin_, spin_speed_;      // half the difference of the wheel angles
+  double rest_imu_;               // pitch at which the body rests on ground
+  double time_;                   // simulated time, stamped on the samples
+
+  // Latest commands
+  double currents_[2];
+  ArmMode arm_mode_[2];
+  double arm_command_[2][7];  // velocities or target positions
+  Somatic__WaistMode waist_mode_;
+  bool torso_halted_;
+  double torso_velocity_;
+};
+
+#endif  // KRANG_BALANCING_SIM_HARDWARE_INTERFACE_H_
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file spsc_ring.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Lock-free single-producer single-consumer ring buffer
+ */
+
+#ifndef KRANG_BALANCING_SPSC_RING_H_
+#define KRANG_BALANCING_SPSC_RING_H_
+
+#include <assert.h>  // assert()
+#include <stddef.h>  // size_t
+
+#include <atomic>  // std::atomic
+
+// Fixed-capacity queue between exactly one producer thread and one consumer
+// thread. All memory is allocated in the constructor, so pushing and popping
+// never allocate, lock or wait. Pushing into a full ring fails instead of
+// overwriting the oldest element
+template <typename T>
+class SpscRing {
+ public:
+  // capacity: maximum number of queued elements, must be a power of two
+  explicit SpscRing(size_t capacity)
+      : capacity_(capacity), mask_(capacity - 1), head_(0), tail_(0) {
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0 &&
+           "SpscRing capacity must be a power of two");
+    buffer_ = new T[capacity];
+  }
+  ~SpscRing() { delete[] buffer_; }
+
+  // Called by the producer. Returns false if the ring is full
+  bool TryPush(const T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == capacity_)
+      return false;
+    buffer_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Called by the consumer. Returns false if the ring is empty
+  bool TryPop(T* value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    *value = buffer_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  // Not copyable
+  SpscRing(const SpscRing&);
+  SpscRing& operator=(const SpscRing&);
+
+  T* buffer_;
+  const size_t capacity_;
+  const size_t mask_;
+  std::atomic<size_t> head_;  // next element to pop, written by the consumer
+  std::atomic<size_t> tail_;  // next slot to push, written by the producer
+};
+
+#endif  // KRANG_BALANCING_SPSC_RING_H_
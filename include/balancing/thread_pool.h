@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file thread_pool.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for thread_pool.cpp that runs independent tasks on all cores
+ */
+
+#ifndef KRANG_BALANCING_THREAD_POOL_H_
+#define KRANG_BALANCING_THREAD_POOL_H_
+
+#include <pthread.h>  // pthread_t, pthread_mutex_t, pthread_cond_t
+
+#include <atomic>      // std::atomic
+#include <deque>       // std::deque
+#include <functional>  // std::function
+#include <vector>      // std::vector
+
+// Fixed set of worker threads with one task queue each. Submitted tasks are
+// spread over the queues; a worker takes from the back of its own queue and,
+// when that is empty, steals from the front of the others, so that long and
+// short tasks even out across the cores without a shared queue
+class ThreadPool {
+ public:
+  // num_threads: number of workers, or the number of online cores if not
+  // positive
+  explicit ThreadPool(int num_threads);
+
+  // Finishes the queued tasks and joins the workers
+  ~ThreadPool();
+
+  // Queues a task. May be called from any thread, including the workers
+  void Submit(const std::function<void()>& task);
+
+  // Blocks until every submitted task has finished
+  void Wait();
+
+  int num_threads() const { return workers_.size(); }
+
+  // Number of tasks that were run by a worker other than the one they were
+  // queued on
+  unsigned long num_steals() const { return num_steals_.load(); }
+
+ private:
+  struct Worker {
+    ThreadPool* pool;
+    int index;
+    pthread_t thread;
+    pthread_mutex_t mutex;  // guards tasks
+    std::deque<std::function<void()> > tasks;
+  };
+
+  // Not copyable
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator=(const ThreadPool&);
+
+  // Body of the worker threads
+  static void* Run(void* arg);
+
+  // Takes a task from the worker's own queue, or from another one
+  bool Pop(int index, std::function<void()>* task);
+  bool Steal(int index, std::function<void()>* task);
+
+  std::vector<Worker*> workers_;
+  std::atomic<unsigned int> next_queue_;       // queue of the next Submit()
+  std::atomic<long> num_queued_;               // tasks waiting in the queues
+  std::atomic<long> num_unfinished_;           // tasks submitted, not done
+  std::atomic<unsigned long> num_steals_;
+  bool stopping_;                              // guarded by mutex_
+  pthread_mutex_t mutex_;       // for sleeping workers and waiters
+  pthread_cond_t work_cond_;    // signalled when a task is queued
+  pthread_cond_t done_cond_;    // signalled when the last task finishes
+};
+
+#endif  // KRANG_BALANCING_THREAD_POOL_H_
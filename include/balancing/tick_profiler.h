@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file tick_profiler.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for tick_profiler.cpp that measures how long each stage of an
+ * iteration of the main loop takes
+ */
+
+#ifndef KRANG_BALANCING_TICK_PROFILER_H_
+#define KRANG_BALANCING_TICK_PROFILER_H_
+
+#include <stdint.h>  // uint64_t
+#include <time.h>    // struct timespec
+
+// Fixed-memory histogram of durations in nanoseconds. Buckets are exact below
+// 16 ns and then split every power of two into 16 linear sub-buckets, so that
+// the relative error of a reported percentile is at most 1/16 over the whole
+// range. Recording a value is a handful of integer operations and never
+// allocates
+class LatencyHistogram {
+ public:
+  LatencyHistogram() { Reset(); }
+  ~LatencyHistogram() {}
+
+  // Adds a duration in nanoseconds to the histogram
+  void Record(uint64_t ns);
+
+  // Clears all recorded values
+  void Reset();
+
+  // Returns the smallest upper bucket bound under which the given fraction
+  // (0.0 - 1.0) of the recorded values lie. Returns 0 if nothing was recorded
+  uint64_t Percentile(double fraction) const;
+
+  // Getters
+  uint64_t count() const { return count_; }
+  uint64_t max() const { return max_; }
+  double mean() const { return (count_ == 0 ? 0.0 : (double)sum_ / count_); }
+
+ private:
+  static const int kSubBucketBits = 4;
+  static const int kSubBuckets = 1 << kSubBucketBits;
+  static const int kMaxExponent = 40;  // values from 2^40 ns (~18 min) on
+                                       // are put in the last bucket
+  static const int kNumBuckets = (kMaxExponent - kSubBucketBits + 1) *
+                                 kSubBuckets;
+
+  // Bucket that a value falls in, and the largest value held by a bucket
+  static int BucketIndex(uint64_t ns);
+  static uint64_t BucketUpperBound(int index);
+
+  uint64_t buckets_[kNumBuckets];
+  uint64_t count_;
+  uint64_t sum_;
+  uint64_t max_;
+};
+
+// Times the consecutive stages of every iteration of a loop. Each call to
+// EndStage() records the time since the previous mark in the histogram of that
+// stage and the call to EndTick() records the time since BeginTick(). A copy
+// holds the histograms as they were, for another thread to print
+class TickProfiler {
+ public:
+  // stage_names: names of the stages used when dumping the histograms, the
+  // array must outlive the profiler
+  // num_stages: number of stages, at most kMaxStages
+  TickProfiler(const char* const* stage_names, int num_stages);
+  ~TickProfiler() {}
+
+  // Marks the beginning of an iteration
+  void BeginTick();
+
+  // Marks the end of the given stage (and the beginning of the next one)
+  void EndStage(int stage);
+
+  // Marks the end of an iteration
+  void EndTick();
+
+  // Dump count, mean, p50, p99, p99.9 and max of every stage on the screen
+  void Print() const;
+
+  // Clears all histograms
+  void Reset();
+
+  static const int kMaxStages = 16;
+
+ private:
+  const char* const* stage_names_;
+  int num_stages_;
+  LatencyHistogram stages_[kMaxStages];
+  LatencyHistogram tick_;
+  struct timespec tick_start_, last_mark_;
+};
+
+#endif  // KRANG_BALANCING_TICK_PROFILER_H_
@@ -44,21 +44,20 @@
 #ifndef KRANG_BALANCING_TORSO_H_
 #define KRANG_BALANCING_TORSO_H_
 
-#include <somatic.h>
-#include <somatic/daemon.h>
-#include <kore.hpp>
+#include "hardware_interface.h"
 
 /* *********************************************************************************************
  */
 struct TorsoState {
+  TorsoState() : mode(kStop), command_val(0.0), last_mode(kStop) {}
   enum TorsoMode { kStop, kMove } mode;
   double command_val;
+  TorsoMode last_mode;  // mode in the previous call to ControlTorso()
 };
 
 /* *********************************************************************************************
  */
 /// Controls the torso
-void ControlTorso(somatic_d_t& daemon_cx, TorsoState& torso_state,
-                  Krang::Hardware* krang);
+void ControlTorso(TorsoState& torso_state, HardwareInterface* hw);
 
 #endif  // KRANG_BALANCING_TORSO_H_
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file upper_body.h
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Header for upper_body.cpp that controls the arms, waist and torso at
+ * a lower rate than the balancing loop
+ */
+
+#ifndef KRANG_BALANCING_UPPER_BODY_H_
+#define KRANG_BALANCING_UPPER_BODY_H_
+
+#include <pthread.h>  // pthread_t
+
+#include <atomic>  // std::atomic
+
+#include <somatic.pb-c.h>  // Somatic__WaistMode
+
+#include "arms.h"                // ArmControl
+#include "balancing_config.h"    // BalancingConfig
+#include "hardware_interface.h"  // HardwareInterface
+#include "seqlock.h"             // SeqLock
+#include "torso.h"               // TorsoState
+
+// Runs ArmControl::ControlArms(), ControlWaist() and ControlTorso() once every
+// upperBodyRateDivider periods of the balancing loop, on a thread of its own
+// so that the commands to the arms, waist and torso never delay the wheel
+// currents. The balancing thread keeps handling the events with its own
+// ArmControl (made without a HardwareInterface), TorsoState and waist mode,
+// and publishes them every iteration; the upper body thread applies the
+// newest ones at its next tick. Neither thread waits for the other.
+//
+// Without a thread (Start() not called), Tick() is called from the loop
+// instead, e.g. when the robot is simulated in the same thread
+class UpperBodyExecutor {
+ public:
+  // rate: of the balancing loop (Hz). The commands go through hw, which must
+  // allow the calls of the upper body concurrently with ReadSensors() and
+  // SetWheelCurrents() if the thread is started (see hardware_interface.h)
+  UpperBodyExecutor(HardwareInterface* hw, BalancingConfig& params,
+                    double rate);
+  ~UpperBodyExecutor();
+
+  // Runs the upper body thread at rate / upperBodyRateDivider. Does nothing
+  // if the rate is not positive
+  void Start();
+  void Stop();
+
+  // Called by the balancing thread after the events of the iteration
+  void Publish(const ArmControl& arm_control, Somatic__WaistMode waist_mode,
+               const TorsoState& torso_state);
+
+  // Controls the upper body with the newest commands. Called by the thread,
+  // or by the loop every divider() iterations if there is no thread
+  void Tick();
+
+  // Getters
+  bool running() const { return running_.load(); }
+  int divider() const { return divider_; }
+  unsigned long num_ticks() const { return num_ticks_.load(); }
+
+ private:
+  // Plain copy of the commands set by the events
+  struct Command {
+    int arm_mode;  // ArmControl::ArmMode
+    int preset_config_num;
+    double arm_command_vals[7];
+    unsigned long num_lock_unlock_events;
+    int waist_mode;  // Somatic__WaistMode
+    int torso_mode;  // TorsoState::TorsoMode
+    double torso_command_val;
+  };
+
+  // Not copyable
+  UpperBodyExecutor(const UpperBodyExecutor&);
+  UpperBodyExecutor& operator=(const UpperBodyExecutor&);
+
+  // Body of the upper body thread
+  static void* Run(void* arg);
+
+  HardwareInterface* hw_;
+  double rate_;  // of the upper body (Hz)
+  int divider_;
+
+  SeqLock<Command> command_;  // written by the balancing thread
+
+  // Upper body thread only
+  ArmControl arm_control_;
+  TorsoState torso_state_;
+  Somatic__WaistMode waist_mode_;
+  unsigned long num_lock_unlock_events_;  // applied to arm_control_
+
+  std::atomic<unsigned long> num_ticks_;
+  std::atomic<bool> running_;
+  pthread_t thread_;
+};
+
+#endif  // KRANG_BALANCING_UPPER_BODY_H_
@@ -44,10 +44,10 @@
 #ifndef KRANG_BALANCING_WAIST_H_
 #define KRANG_BALANCING_WAIST_H_
 
-#include <kore.hpp>
+#include <somatic.pb-c.h>
 
-Somatic__WaistCmd* waistDaemonCmd = somatic_waist_cmd_alloc();
+#include "hardware_interface.h"
 
-void ControlWaist(Somatic__WaistMode waistMode, Krang::Hardware* krang);
+void ControlWaist(Somatic__WaistMode waistMode, HardwareInterface* hw);
 
 #endif  // KRANG_BALANCING_WAIST_H_
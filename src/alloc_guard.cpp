@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file alloc_guard.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Catches heap allocations in code that must not allocate
+ */
+
+#include "balancing/alloc_guard.h"
+
+#include <stdlib.h>  // abort(), size_t
+#include <string.h>  // strlen()
+#include <unistd.h>  // write(), ssize_t
+
+#ifdef BALANCING_ALLOC_GUARD
+
+// The allocator of glibc, called by the replacements below
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+static __thread int guard_armed = 0;
+static __thread unsigned long guard_calls = 0;
+
+#if BALANCING_ALLOC_GUARD == 2
+/* ************************************************************************* */
+// Writes to stderr without touching the heap. Nothing can be done about a
+// failed write right before abort(), so the result is dropped
+static void WriteStderr(const char* text, size_t length) {
+  ssize_t written = write(STDERR_FILENO, text, length);
+  (void)written;
+}
+#endif
+
+/* ************************************************************************* */
+// Called on every heap call made while armed. Must not touch the heap itself,
+// so the message is written with write()
+static void CaughtHeapCall(const char* function) {
+  guard_calls++;
+#if BALANCING_ALLOC_GUARD == 2
+  guard_armed = 0;
+  const char kMessage[] = "[ERR ] AllocGuard: heap call in guarded code: ";
+  WriteStderr(kMessage, sizeof(kMessage) - 1);
+  WriteStderr(function, strlen(function));
+  WriteStderr("()\n", 3);
+  abort();
+#else
+  (void)function;  // only reported when aborting
+#endif
+}
+
+/* ************************************************************************* */
+extern "C" void* malloc(size_t size) {
+  if (guard_armed) CaughtHeapCall("malloc");
+  return __libc_malloc(size);
+}
+
+/* ************************************************************************* */
+extern "C" void* calloc(size_t num, size_t size) {
+  if (guard_armed) CaughtHeapCall("calloc");
+  return __libc_calloc(num, size);
+}
+
+/* ************************************************************************* */
+extern "C" void* realloc(void* ptr, size_t size) {
+  if (guard_armed) CaughtHeapCall("realloc");
+  return __libc_realloc(ptr, size);
+}
+
+/* ************************************************************************* */
+extern "C" void free(void* ptr) {
+  if (guard_armed && ptr != NULL) CaughtHeapCall("free");
+  __libc_free(ptr);
+}
+
+/* ************************************************************************* */
+void AllocGuardArm() {
+  guard_calls = 0;
+  guard_armed = 1;
+}
+
+/* ************************************************************************* */
+unsigned long AllocGuardDisarm() {
+  guard_armed = 0;
+  return guard_calls;
+}
+
+/* ************************************************************************* */
+bool AllocGuardEnabled() { return true; }
+
+#else  // BALANCING_ALLOC_GUARD
+
+/* ************************************************************************* */
+void AllocGuardArm() {}
+
+/* ************************************************************************* */
+unsigned long AllocGuardDisarm() { return 0; }
+
+/* ************************************************************************* */
+bool AllocGuardEnabled() { return false; }
+
+#endif  // BALANCING_ALLOC_GUARD
@@ -42,17 +42,14 @@
 
 #include "balancing/arms.h"
 
+#include <assert.h>
 #include <math.h>
 #include <unistd.h>
 
-#include <somatic.h>
-#include <somatic/daemon.h>
-#include <somatic/motor.h>
-
-#include <kore.hpp>
-#include <kore/util.hpp>
+#include <iostream>
 
 #include "balancing/balancing_config.h"
+#include "balancing/hardware_interface.h"
 
 /* ************************************************************************************/
 // The preset arm configurations: forward, thriller, goodJacobian
@@ -69,15 +66,20 @@ double ArmControl::presetArmConfs[][7] = {
 
 /* ************************************************************************************/
 /// Constructor
-ArmControl::ArmControl(somatic_d_t* daemon_cx_, Krang::Hardware* krang_,
-                       BalancingConfig& params)
-    : krang(krang_), daemon_cx(daemon_cx_) {
+ArmControl::ArmControl(HardwareInterface* hw_, BalancingConfig& params)
+    : hw(hw_) {
   event_based_lock_unlock = params.manualArmLockUnlock;
-  somatic_motor_halt(daemon_cx, krang->arms[Krang::LEFT]);
-  somatic_motor_halt(daemon_cx, krang->arms[Krang::RIGHT]);
-  usleep(1e5);
+  if (hw != NULL) {
+    hw->HaltArm(HardwareInterface::LEFT);
+    hw->HaltArm(HardwareInterface::RIGHT);
+    usleep(1e5);
+  }
   halted = true;
   mode = kStop;
+  last_mode = kStop;
+  preset_config_num = 0;
+  for (int i = 0; i < 7; i++) command_vals[i] = 0.0;
+  num_lock_unlock_events = 0;
 }
 
 /* ************************************************************************************/
@@ -94,7 +96,7 @@ bool ArmControl::ArmResetIfNeeded(ArmControl::ArmMode& last_mode) {
          mode == ArmControl::kMoveLeftSmallSet ||
          mode == ArmControl::kMoveLeftToPresetPos ||
          mode == ArmControl::kMoveBothToPresetPos)) {
-      somatic_motor_reset(daemon_cx, krang->arms[Krang::LEFT]);
+      hw->ResetArm(HardwareInterface::LEFT);
 
       // return to allow delay after reset (assuming that by the time this
       // function is called again, some time will have passed)
@@ -113,7 +115,7 @@ bool ArmControl::ArmResetIfNeeded(ArmControl::ArmMode& last_mode) {
               mode == ArmControl::kMoveRightSmallSet ||
               mode == ArmControl::kMoveRightToPresetPos ||
               mode == ArmControl::kMoveBothToPresetPos)) {
-      somatic_motor_reset(daemon_cx, krang->arms[Krang::RIGHT]);
+      hw->ResetArm(HardwareInterface::RIGHT);
 
       // return to allow delay after reset
       last_mode = mode;
@@ -130,36 +132,39 @@ bool ArmControl::ArmResetIfNeeded(ArmControl::ArmMode& last_mode) {
 /// event_based_lock_unlock flag
 void ArmControl::StopLeftArm() {
   if (!event_based_lock_unlock) {
-    somatic_motor_halt(daemon_cx, krang->arms[Krang::LEFT]);
+    hw->HaltArm(HardwareInterface::LEFT);
   } else {
     double dq[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-    somatic_motor_cmd(daemon_cx, krang->arms[Krang::LEFT],
-                      SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 7, NULL);
+    hw->SetArmVelocities(HardwareInterface::LEFT, dq);
   }
 }
 void ArmControl::StopRightArm() {
   if (!event_based_lock_unlock) {
-    somatic_motor_halt(daemon_cx, krang->arms[Krang::RIGHT]);
+    hw->HaltArm(HardwareInterface::RIGHT);
   } else {
     double dq[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-    somatic_motor_cmd(daemon_cx, krang->arms[Krang::RIGHT],
-                      SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 7, NULL);
+    hw->SetArmVelocities(HardwareInterface::RIGHT, dq);
   }
 }
 /* ************************************************************************************/
 void ArmControl::ArmLockEvent() {
   if (event_based_lock_unlock) {
-    somatic_motor_halt(daemon_cx, krang->arms[Krang::LEFT]);
-    somatic_motor_halt(daemon_cx, krang->arms[Krang::RIGHT]);
+    hw->HaltArm(HardwareInterface::LEFT);
+    hw->HaltArm(HardwareInterface::RIGHT);
   }
 }
 void ArmControl::ArmUnlockEvent() {
   if (event_based_lock_unlock) {
-    somatic_motor_reset(daemon_cx, krang->arms[Krang::LEFT]);
-    somatic_motor_reset(daemon_cx, krang->arms[Krang::RIGHT]);
+    hw->ResetArm(HardwareInterface::LEFT);
+    hw->ResetArm(HardwareInterface::RIGHT);
   }
 }
 void ArmControl::LockUnlockEvent() {
+  num_lock_unlock_events++;
+  if (hw == NULL) {
+    halted = !halted;
+    return;
+  }
   if (halted) {
     ArmUnlockEvent();
     halted = false;
@@ -175,8 +180,6 @@ void ArmControl::ControlArms() {
   // No control command should be sent to the motors when they are locked
   if (event_based_lock_unlock && halted) return;
 
-  static ArmControl::ArmMode last_mode = ArmControl::kStop;
-
   // If event_based_lock_unlock is not active, unlock the arm if it just
   // began to be used
   // Return if a reset was performed, this allows delay till next iteration to
@@ -199,8 +202,7 @@ void ArmControl::ControlArms() {
       // motors
       double dq[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
       for (int i = 0; i < 4; i++) dq[i] = command_vals[i];
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::LEFT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 7, NULL);
+      hw->SetArmVelocities(HardwareInterface::LEFT, dq);
       break;
     }
     case ArmControl::kMoveLeftSmallSet: {
@@ -211,8 +213,7 @@ void ArmControl::ControlArms() {
       // motors
       double dq[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
       for (int i = 4; i < 7; i++) dq[i] = command_vals[i];
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::LEFT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 7, NULL);
+      hw->SetArmVelocities(HardwareInterface::LEFT, dq);
       break;
     }
     case ArmControl::kMoveRightBigSet: {
@@ -223,8 +224,7 @@ void ArmControl::ControlArms() {
       // others
       double dq[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
       for (int i = 0; i < 4; i++) dq[i] = command_vals[i];
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::RIGHT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 7, NULL);
+      hw->SetArmVelocities(HardwareInterface::RIGHT, dq);
       break;
     }
     case ArmControl::kMoveRightSmallSet: {
@@ -235,8 +235,7 @@ void ArmControl::ControlArms() {
       // others
       double dq[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
       for (int i = 4; i < 7; i++) dq[i] = command_vals[i];
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::RIGHT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 7, NULL);
+      hw->SetArmVelocities(HardwareInterface::RIGHT, dq);
       break;
     }
     case ArmControl::kMoveLeftToPresetPos: {
@@ -244,9 +243,8 @@ void ArmControl::ControlArms() {
       StopRightArm();
 
       // Send preset config positions to left arm
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::LEFT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_POSITION,
-                        presetArmConfs[2 * preset_config_num], 7, NULL);
+      hw->SetArmPositions(HardwareInterface::LEFT,
+                          presetArmConfs[2 * preset_config_num]);
       break;
     }
     case ArmControl::kMoveRightToPresetPos: {
@@ -254,19 +252,16 @@ void ArmControl::ControlArms() {
       StopLeftArm();
 
       // Send preset config position to the right arm
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::RIGHT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_POSITION,
-                        presetArmConfs[2 * preset_config_num + 1], 7, NULL);
+      hw->SetArmPositions(HardwareInterface::RIGHT,
+                          presetArmConfs[2 * preset_config_num + 1]);
       break;
     }
     case ArmControl::kMoveBothToPresetPos: {
       // Send present config positions to both arms
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::LEFT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_POSITION,
-                        presetArmConfs[2 * preset_config_num], 7, NULL);
-      somatic_motor_cmd(daemon_cx, krang->arms[Krang::RIGHT],
-                        SOMATIC__MOTOR_PARAM__MOTOR_POSITION,
-                        presetArmConfs[2 * preset_config_num + 1], 7, NULL);
+      hw->SetArmPositions(HardwareInterface::LEFT,
+                          presetArmConfs[2 * preset_config_num]);
+      hw->SetArmPositions(HardwareInterface::RIGHT,
+                          presetArmConfs[2 * preset_config_num + 1]);
       break;
     }
     default: {
@@ -53,6 +53,13 @@
 // of cfg file from the parameters are to be read. Second argument is the output
 // where the parameters are stored
 void ReadConfigParams(const char* config_file, BalancingConfig* params) {
+  bool success = TryReadConfigParams(config_file, params);
+  assert(success && "Problem reading config parameters");
+}
+
+// Same as ReadConfigParams() but returns false instead of asserting if the
+// file cannot be parsed, a parameter is missing or a list of numbers is short
+bool TryReadConfigParams(const char* config_file, BalancingConfig* params) {
   // Initialize the reader of the cfg file
   config4cpp::Configuration* cfg = config4cpp::Configuration::create();
   const char* scope = "";
@@ -60,6 +67,7 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
   // Temporaries we use for reading from config4cpp structure
   const char* str;
   std::istringstream stream;
+  bool success = true;
 
   std::cout << "Reading configuration parameters ..." << std::endl;
   try {
@@ -85,6 +93,11 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
       str = cfg->lookupString(scope, pdGainsStrings[i]);
       stream.str(str);
       for (int j = 0; j < 6; j++) stream >> (*(pdGains[i]))(j);
+      if (stream.fail()) {
+        std::cout << "[ERR ] " << pdGainsStrings[i] << " needs 6 numbers"
+                  << std::endl;
+        success = false;
+      }
       stream.clear();
       std::cout << pdGainsStrings[i] << ": ";
       std::cout << (*(pdGains[i])).transpose() << std::endl;
@@ -102,6 +115,11 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
       str = cfg->lookupString(scope, joystickGainsStrings[i]);
       stream.str(str);
       for (int j = 0; j < 2; j++) stream >> joystickGains[i][j];
+      if (stream.fail()) {
+        std::cout << "[ERR ] " << joystickGainsStrings[i] << " needs 2 numbers"
+                  << std::endl;
+        success = false;
+      }
       stream.clear();
       std::cout << joystickGainsStrings[i] << ": ";
       std::cout << joystickGains[i][0] << "  ";
@@ -117,6 +135,10 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
     str = cfg->lookupString(scope, "lqrQ");
     stream.str(str);
     for (int i = 0; i < 4; i++) stream >> params->lqrQ(i, i);
+    if (stream.fail()) {
+      std::cout << "[ERR ] lqrQ needs 4 numbers" << std::endl;
+      success = false;
+    }
     stream.clear();
     std::cout << "lqrQ: " << params->lqrQ << std::endl;
 
@@ -125,9 +147,39 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
     str = cfg->lookupString(scope, "lqrR");
     stream.str(str);
     for (int i = 0; i < 1; i++) stream >> params->lqrR(i, i);
+    if (stream.fail()) {
+      std::cout << "[ERR ] lqrR needs 1 number" << std::endl;
+      success = false;
+    }
     stream.clear();
     std::cout << "lqrR: " << params->lqrR << std::endl;
 
+    // Source of the dynamic LQR gains
+    strncpy(params->lqrGainSource, cfg->lookupString(scope, "lqrGainSource"),
+            sizeof(params->lqrGainSource) - 1);
+    params->lqrGainSource[sizeof(params->lqrGainSource) - 1] = '\0';
+    std::cout << "lqrGainSource: " << params->lqrGainSource << std::endl;
+    strcpy(params->lqrGainTablePath,
+           cfg->lookupString(scope, "lqrGainTablePath"));
+    std::cout << "lqrGainTablePath: " << params->lqrGainTablePath << std::endl;
+    params->lqrGainTableArmTolerance =
+        cfg->lookupFloat(scope, "lqrGainTableArmTolerance");
+    std::cout << "lqrGainTableArmTolerance: "
+              << params->lqrGainTableArmTolerance << std::endl;
+    params->lqrGainCacheSize = cfg->lookupInt(scope, "lqrGainCacheSize");
+    std::cout << "lqrGainCacheSize: " << params->lqrGainCacheSize << std::endl;
+    params->lqrGainCacheQuantum =
+        cfg->lookupFloat(scope, "lqrGainCacheQuantum");
+    std::cout << "lqrGainCacheQuantum: " << params->lqrGainCacheQuantum
+              << std::endl;
+    params->lqrRelinearizeTolerance =
+        cfg->lookupFloat(scope, "lqrRelinearizeTolerance");
+    std::cout << "lqrRelinearizeTolerance: "
+              << params->lqrRelinearizeTolerance << std::endl;
+    params->lqrWarmStart = cfg->lookupBoolean(scope, "lqrWarmStart");
+    std::cout << "lqrWarmStart: ";
+    std::cout << (params->lqrWarmStart ? "true" : "false") << std::endl;
+
     // Read parameters for bal control mode transition
     params->imuSitAngle = cfg->lookupFloat(scope, "imuSitAngle");
     std::cout << "imuSitAngle :" << params->imuSitAngle << std::endl;
@@ -148,6 +200,69 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
     std::cout << "manualArmLockUnlock: ";
     std::cout << (params->manualArmLockUnlock ? "true" : "false") << std::endl;
 
+    // Rate of the main loop
+    params->controlRate = cfg->lookupFloat(scope, "controlRate");
+    std::cout << "controlRate: " << params->controlRate << std::endl;
+    params->upperBodyRateDivider =
+        cfg->lookupInt(scope, "upperBodyRateDivider");
+    std::cout << "upperBodyRateDivider: " << params->upperBodyRateDivider
+              << std::endl;
+    params->sensorTimeStep = cfg->lookupBoolean(scope, "sensorTimeStep");
+    std::cout << "sensorTimeStep: ";
+    std::cout << (params->sensorTimeStep ? "true" : "false") << std::endl;
+    params->dtFilterGain = cfg->lookupFloat(scope, "dtFilterGain");
+    std::cout << "dtFilterGain: " << params->dtFilterGain << std::endl;
+    params->maxTimeStep = cfg->lookupFloat(scope, "maxTimeStep");
+    std::cout << "maxTimeStep: " << params->maxTimeStep << std::endl;
+
+    // Joystick
+    params->joystickTimeoutMs = cfg->lookupFloat(scope, "joystickTimeoutMs");
+    std::cout << "joystickTimeoutMs: " << params->joystickTimeoutMs
+              << std::endl;
+
+    // Flight recorder
+    strcpy(params->flightRecorderPath,
+           cfg->lookupString(scope, "flightRecorderPath"));
+    std::cout << "flightRecorderPath: " << params->flightRecorderPath
+              << std::endl;
+    params->flightRecorderCapacity =
+        cfg->lookupInt(scope, "flightRecorderCapacity");
+    std::cout << "flightRecorderCapacity: " << params->flightRecorderCapacity
+              << std::endl;
+
+    // Simulation backend
+    params->inProcessSimulation =
+        cfg->lookupBoolean(scope, "inProcessSimulation");
+    std::cout << "inProcessSimulation: ";
+    std::cout << (params->inProcessSimulation ? "true" : "false") << std::endl;
+
+    // Hot reload of the gains and thresholds
+    params->reloadConfig = cfg->lookupBoolean(scope, "reloadConfig");
+    std::cout << "reloadConfig: ";
+    std::cout << (params->reloadConfig ? "true" : "false") << std::endl;
+
+    // Real-time setup
+    params->rtPriority = cfg->lookupInt(scope, "rtPriority");
+    std::cout << "rtPriority: " << params->rtPriority << std::endl;
+    strncpy(params->rtControlCpus, cfg->lookupString(scope, "rtControlCpus"),
+            sizeof(params->rtControlCpus) - 1);
+    params->rtControlCpus[sizeof(params->rtControlCpus) - 1] = '\0';
+    std::cout << "rtControlCpus: " << params->rtControlCpus << std::endl;
+    strncpy(params->rtAuxiliaryCpus,
+            cfg->lookupString(scope, "rtAuxiliaryCpus"),
+            sizeof(params->rtAuxiliaryCpus) - 1);
+    params->rtAuxiliaryCpus[sizeof(params->rtAuxiliaryCpus) - 1] = '\0';
+    std::cout << "rtAuxiliaryCpus: " << params->rtAuxiliaryCpus << std::endl;
+    params->rtLockMemory = cfg->lookupBoolean(scope, "rtLockMemory");
+    std::cout << "rtLockMemory: ";
+    std::cout << (params->rtLockMemory ? "true" : "false") << std::endl;
+    params->rtPrefaultStackKb = cfg->lookupInt(scope, "rtPrefaultStackKb");
+    std::cout << "rtPrefaultStackKb: " << params->rtPrefaultStackKb
+              << std::endl;
+    params->rtPrefaultHeapKb = cfg->lookupInt(scope, "rtPrefaultHeapKb");
+    std::cout << "rtPrefaultHeapKb: " << params->rtPrefaultHeapKb
+              << std::endl;
+
     // Max input current in simulation mode
     if (params->is_simulation_) {
       params->sim_max_input_current_ = cfg->lookupFloat(scope, "maxInputCurrent");
@@ -156,10 +271,11 @@ void ReadConfigParams(const char* config_file, BalancingConfig* params) {
 
   } catch (const config4cpp::ConfigurationException& ex) {
     std::cerr << ex.c_str() << std::endl;
-    cfg->destroy();
-    assert(false && "Problem reading config parameters");
+    success = false;
   }
+  cfg->destroy();
   std::cout << std::endl;
+  return success;
 }
 
 // Read the parameter named "time_step" from the give config file
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file com_engine.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Computes the center of mass of the robot without the wheels,
+ * reusing the parts of the previous computation that are still valid
+ */
+
+#include "balancing/com_engine.h"
+
+#include <assert.h>  // assert()
+
+#include <algorithm>  // std::find()
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+#include <Eigen/Eigen>    // Eigen::Vector3d, Eigen::Isometry3d
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr, BodyNode, Joint
+
+/* ************************************************************************* */
+ComEngine::ComEngine(dart::dynamics::SkeletonPtr robot,
+                     const std::vector<std::string>& excluded)
+    : robot_(robot), mass_(0.0), valid_(false), num_recomputed_(0) {
+  AddSubtree(robot_->getBodyNode(0), -1, excluded);
+  assert(!bodies_.empty() && "ComEngine: the root body is excluded");
+  changed_.assign(bodies_.size(), 0);
+  UpdateMassProperties();
+}
+
+/* ************************************************************************* */
+void ComEngine::AddSubtree(dart::dynamics::BodyNode* node, int parent,
+                           const std::vector<std::string>& excluded) {
+  if (std::find(excluded.begin(), excluded.end(), node->getName()) !=
+      excluded.end())
+    return;
+
+  Body body;
+  body.node = node;
+  body.parent = parent;
+  dart::dynamics::Joint* joint = node->getParentJoint();
+  for (size_t i = 0; i < joint->getNumDofs(); i++)
+    body.dofs.push_back(joint->getIndexInSkeleton(i));
+  body.q.assign(body.dofs.size(), 0.0);
+  int index = bodies_.size();
+  bodies_.push_back(body);
+  if (parent >= 0) bodies_[parent].children.push_back(index);
+
+  for (size_t i = 0; i < robot_->getNumBodyNodes(); i++) {
+    dart::dynamics::BodyNode* child = robot_->getBodyNode(i);
+    if (child->getParentBodyNode() == node)
+      AddSubtree(child, index, excluded);
+  }
+}
+
+/* ************************************************************************* */
+void ComEngine::UpdateMassProperties() {
+  mass_ = 0.0;
+  for (size_t i = 0; i < bodies_.size(); i++) {
+    bodies_[i].mass = bodies_[i].node->getMass();
+    bodies_[i].mass_com = bodies_[i].mass * bodies_[i].node->getLocalCOM();
+    mass_ += bodies_[i].mass;
+  }
+  valid_ = false;
+}
+
+/* ************************************************************************* */
+bool ComEngine::JointMoved(Body* body) {
+  bool moved = false;
+  for (size_t i = 0; i < body->dofs.size(); i++) {
+    double q = robot_->getPosition(body->dofs[i]);
+    if (q != body->q[i]) {
+      body->q[i] = q;
+      moved = true;
+    }
+  }
+  return moved;
+}
+
+/* ************************************************************************* */
+Eigen::Vector3d ComEngine::Com() {
+  // Children come after their parents, so going backwards every subtree is
+  // up to date before the subtree of its parent is summed. A subtree needs
+  // to be summed again if the joint of a child moved or the subtree of a
+  // child changed
+  num_recomputed_ = 0;
+  for (int i = bodies_.size() - 1; i >= 0; i--) {
+    Body& body = bodies_[i];
+    bool moved = JointMoved(&body);
+    bool recompute = !valid_;
+    for (size_t j = 0; j < body.children.size() && !recompute; j++)
+      recompute = changed_[body.children[j]];
+    if (recompute) {
+      body.subtree_mass = body.mass;
+      body.subtree_mass_com = body.mass_com;
+      for (size_t j = 0; j < body.children.size(); j++) {
+        const Body& child = bodies_[body.children[j]];
+        const Eigen::Isometry3d& transform =
+            child.node->getRelativeTransform();
+        body.subtree_mass += child.subtree_mass;
+        body.subtree_mass_com += transform.linear() * child.subtree_mass_com +
+                                 child.subtree_mass * transform.translation();
+      }
+      num_recomputed_++;
+    }
+
+    // The parent sees this subtree through the joint of this body
+    changed_[i] = (recompute || moved);
+  }
+  valid_ = true;
+
+  // The root moves with the base in every iteration
+  const Body& root = bodies_[0];
+  return root.node->getWorldTransform() *
+         (root.subtree_mass_com / root.subtree_mass);
+}
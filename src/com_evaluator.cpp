@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file com_evaluator.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Evaluates the center of mass of the robot directly from its joint
+ * angles
+ */
+
+#include "balancing/com_evaluator.h"
+
+#include <algorithm>  // std::find()
+#include <iostream>   // std::cout, std::endl
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+#include <Eigen/Eigen>    // Eigen::Matrix3d, Eigen::Vector3d, Eigen::AngleAxisd
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr, BodyNode, Joint
+
+#include "balancing/com_kernel.h"  // WeightedComSum(), kComKernelLanes
+
+/* ************************************************************************* */
+bool ComEvaluator::Compile(dart::dynamics::SkeletonPtr robot,
+                           const std::vector<std::string>& excluded) {
+  links_.clear();
+  mass_ = 0.0;
+
+  // Body node indices follow the tree, parents first, so a body is kept if
+  // its parent was kept
+  std::vector<int> link_of_body(robot->getNumBodyNodes(), -1);
+  for (size_t i = 0; i < robot->getNumBodyNodes(); i++) {
+    dart::dynamics::BodyNode* body = robot->getBodyNode(i);
+    if (std::find(excluded.begin(), excluded.end(), body->getName()) !=
+        excluded.end())
+      continue;
+    dart::dynamics::BodyNode* parent_body = body->getParentBodyNode();
+    int parent = -1;
+    if (parent_body != NULL) {
+      parent = link_of_body[parent_body->getIndexInSkeleton()];
+      if (parent < 0) continue;  // in an excluded subtree
+    }
+
+    Link link;
+    link.parent = parent;
+    dart::dynamics::Joint* joint = body->getParentJoint();
+    const std::string& type = joint->getType();
+    if (type == dart::dynamics::FreeJoint::getStaticType() && parent < 0) {
+      link.type = kFree;
+    } else if (type == dart::dynamics::RevoluteJoint::getStaticType()) {
+      link.type = kRevolute;
+      link.axis = static_cast<dart::dynamics::RevoluteJoint*>(joint)->getAxis();
+    } else if (type == dart::dynamics::WeldJoint::getStaticType() &&
+               parent >= 0) {
+      link.type = kWeld;
+    } else {
+      std::cout << "[ERR ] ComEvaluator: unsupported joint " << type
+                << " of " << body->getName() << std::endl;
+      links_.clear();
+      return false;
+    }
+    link.dof = (joint->getNumDofs() > 0 ? joint->getIndexInSkeleton(0) : -1);
+    const Eigen::Isometry3d& parent_to_joint =
+        joint->getTransformFromParentBodyNode();
+    Eigen::Isometry3d joint_to_child =
+        joint->getTransformFromChildBodyNode().inverse();
+    link.parent_R = parent_to_joint.linear();
+    link.parent_t = parent_to_joint.translation();
+    link.child_R = joint_to_child.linear();
+    link.child_t = joint_to_child.translation();
+    link.mass = body->getMass();
+    link.mass_com = link.mass * body->getLocalCOM();
+    link.com = body->getLocalCOM();
+    link.inertia = body->getInertia().getMoment();
+    mass_ += link.mass;
+
+    link_of_body[i] = links_.size();
+    links_.push_back(link);
+  }
+  if (links_.empty() || links_[0].type != kFree) {
+    std::cout << "[ERR ] ComEvaluator: root is not a free joint" << std::endl;
+    links_.clear();
+    return false;
+  }
+  R_.resize(links_.size());
+  t_.resize(links_.size());
+
+  // Masses and local coms in the rows of the com kernel. The padding links
+  // stay zero
+  stride_ = ((links_.size() + kComKernelLanes - 1) / kComKernelLanes) *
+            kComKernelLanes;
+  soa_.assign(kNumComKernelRows * stride_, 0.0);
+  for (size_t i = 0; i < links_.size(); i++) {
+    for (int k = 0; k < 3; k++)
+      soa_[(kComRowMassCom + k) * stride_ + i] = links_[i].mass_com(k);
+    soa_[kComRowMass * stride_ + i] = links_[i].mass;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+Eigen::Vector3d ComEvaluator::Com(const double* q) {
+  for (size_t i = 0; i < links_.size(); i++) {
+    const Link& link = links_[i];
+
+    // Transform of the joint frame in the world
+    Eigen::Matrix3d R;
+    Eigen::Vector3d t;
+    if (link.parent < 0) {
+      R = link.parent_R;
+      t = link.parent_t;
+    } else {
+      R = R_[link.parent] * link.parent_R;
+      t = R_[link.parent] * link.parent_t + t_[link.parent];
+    }
+
+    // Motion of the joint. The rotation of a free joint is the exponential
+    // coordinates in its first three dofs, followed by the translation
+    if (link.type == kRevolute) {
+      R = R * Eigen::AngleAxisd(q[link.dof], link.axis).toRotationMatrix();
+    } else if (link.type == kFree) {
+      Eigen::Vector3d rotation(q[link.dof], q[link.dof + 1], q[link.dof + 2]);
+      Eigen::Vector3d translation(q[link.dof + 3], q[link.dof + 4],
+                                  q[link.dof + 5]);
+      t += R * translation;
+      double angle = rotation.norm();
+      if (angle > 1e-12)
+        R = R * Eigen::AngleAxisd(angle, rotation / angle).toRotationMatrix();
+    }
+
+    // Transform of the body in the world, also stored in the rows of the com
+    // kernel
+    R_[i] = R * link.child_R;
+    t_[i] = R * link.child_t + t;
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++)
+        soa_[(kComRowR + 3 * row + col) * stride_ + i] = R_[i](row, col);
+      soa_[(kComRowT + row) * stride_ + i] = t_[i](row);
+    }
+  }
+
+  // Sum of the mass-weighted coms of all links at once
+  Eigen::Vector3d mass_com;
+  WeightedComSum(&soa_[0], stride_, mass_com.data());
+  com_ = mass_com / mass_;
+  return com_;
+}
+
+/* ************************************************************************* */
+double ComEvaluator::InertiaAbout(const Eigen::Vector3d& point,
+                                  const Eigen::Vector3d& axis) const {
+  double inertia = 0.0;
+  for (size_t i = 0; i < links_.size(); i++) {
+    // Rotational inertia of the body about its com plus that of its mass at
+    // the distance of the com from the line
+    Eigen::Vector3d local_axis = R_[i].transpose() * axis;
+    Eigen::Vector3d offset = R_[i] * links_[i].com + t_[i] - point;
+    inertia += local_axis.dot(links_[i].inertia * local_axis) +
+               links_[i].mass * offset.cross(axis).squaredNorm();
+  }
+  return inertia;
+}
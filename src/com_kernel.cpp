@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file com_kernel.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Sums the mass-weighted coms of many bodies with vector instructions
+ */
+
+#include "balancing/com_kernel.h"
+
+#if defined(BALANCING_AVX2) && defined(__x86_64__)
+#include <immintrin.h>  // _mm256_*
+#define COM_KERNEL_AVX2
+#endif
+
+/* ************************************************************************* */
+// The same order as WeightedComSumAvx2() one lane at a time: one accumulator
+// per lane and coordinate, and the lanes added up pairwise. The multiply-adds
+// are not fused, since std::fma() is emulated in software on cpus without
+// FMA, so the result may differ from the AVX2 code in the last bits
+void WeightedComSumScalar(const double* soa, int stride, double* sum) {
+  const double* R = soa + kComRowR * stride;
+  const double* t = soa + kComRowT * stride;
+  const double* mass_com = soa + kComRowMassCom * stride;
+  const double* mass = soa + kComRowMass * stride;
+  for (int row = 0; row < 3; row++) {
+    const double* R_row = R + 3 * row * stride;
+    double acc[kComKernelLanes] = {0.0, 0.0, 0.0, 0.0};
+    for (int i = 0; i < stride; i += kComKernelLanes) {
+      for (int lane = 0; lane < kComKernelLanes; lane++) {
+        int k = i + lane;
+        acc[lane] += R_row[k] * mass_com[k];
+        acc[lane] += R_row[stride + k] * mass_com[stride + k];
+        acc[lane] += R_row[2 * stride + k] * mass_com[2 * stride + k];
+        acc[lane] += mass[k] * t[row * stride + k];
+      }
+    }
+    sum[row] = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  }
+}
+
+#ifdef COM_KERNEL_AVX2
+/* ************************************************************************* */
+// kComKernelLanes bodies at a time, with one accumulator per coordinate.
+// Compiled for AVX2 whatever the flags of the rest of the library, and only
+// called if the cpu supports it
+__attribute__((target("avx2,fma"))) static void WeightedComSumAvx2(
+    const double* soa, int stride, double* sum) {
+  const double* R = soa + kComRowR * stride;
+  const double* t = soa + kComRowT * stride;
+  const double* mass_com = soa + kComRowMassCom * stride;
+  const double* mass = soa + kComRowMass * stride;
+  __m256d acc[3];
+  for (int row = 0; row < 3; row++) acc[row] = _mm256_setzero_pd();
+  for (int i = 0; i < stride; i += kComKernelLanes) {
+    __m256d mcx = _mm256_loadu_pd(mass_com + i);
+    __m256d mcy = _mm256_loadu_pd(mass_com + stride + i);
+    __m256d mcz = _mm256_loadu_pd(mass_com + 2 * stride + i);
+    __m256d m = _mm256_loadu_pd(mass + i);
+    for (int row = 0; row < 3; row++) {
+      const double* R_row = R + 3 * row * stride + i;
+      acc[row] = _mm256_fmadd_pd(_mm256_loadu_pd(R_row), mcx, acc[row]);
+      acc[row] =
+          _mm256_fmadd_pd(_mm256_loadu_pd(R_row + stride), mcy, acc[row]);
+      acc[row] =
+          _mm256_fmadd_pd(_mm256_loadu_pd(R_row + 2 * stride), mcz, acc[row]);
+      acc[row] = _mm256_fmadd_pd(
+          m, _mm256_loadu_pd(t + row * stride + i), acc[row]);
+    }
+  }
+
+  // Add up the lanes
+  for (int row = 0; row < 3; row++) {
+    double lanes[kComKernelLanes];
+    _mm256_storeu_pd(lanes, acc[row]);
+    sum[row] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+}
+#endif  // COM_KERNEL_AVX2
+
+/* ************************************************************************* */
+bool ComKernelUsesAvx2() {
+#ifdef COM_KERNEL_AVX2
+  static const bool kHasAvx2 =
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return kHasAvx2;
+#else
+  return false;
+#endif
+}
+
+/* ************************************************************************* */
+void WeightedComSum(const double* soa, int stride, double* sum) {
+#ifdef COM_KERNEL_AVX2
+  if (ComKernelUsesAvx2()) {
+    WeightedComSumAvx2(soa, stride, sum);
+    return;
+  }
+#endif
+  WeightedComSumScalar(soa, stride, sum);
+}
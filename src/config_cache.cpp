@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file config_cache.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Keeps the parsed configuration parameters in a binary file for fast
+ * restarts
+ */
+
+#include "balancing/config_cache.h"
+
+#include <assert.h>    // assert()
+#include <errno.h>     // errno
+#include <fcntl.h>     // open()
+#include <stdio.h>     // rename(), remove()
+#include <string.h>    // memset(), memcpy(), memcmp(), strerror(), strlen()
+#include <sys/mman.h>  // mmap(), munmap()
+#include <sys/stat.h>  // fstat()
+#include <unistd.h>    // write(), close()
+
+#include <exception>  // std::exception
+#include <iostream>   // std::cout, std::endl
+#include <string>     // std::string
+
+#include <Eigen/Eigen>               // Eigen::MatrixXd
+#include <krang-utils/file_ops.hpp>  // readInputFileAsMatrix()
+
+#include "balancing/balancing_config.h"  // BalancingConfig, ReadConfigParams()
+
+namespace {
+const char kConfigCacheMagic[8] = "KRANGCC";
+
+// Identifies the contents of a source file of the cache
+struct SourceKey {
+  int64_t mtime_sec, mtime_nsec;
+  int64_t size;
+  uint64_t hash;  // FNV-1a of the bytes
+};
+
+// The header is followed by the BalancingConfig and then by the beta_rows x
+// beta_cols CoM parameters in column-major order
+struct ConfigCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t config_size;  // sizeof(BalancingConfig)
+  uint32_t is_simulation;
+  uint32_t beta_rows, beta_cols;
+  uint32_t padding;
+  uint64_t config_layout;  // ConfigLayout() of the build that wrote it
+  SourceKey config_key;
+  SourceKey beta_key;  // all zero if there are no CoM parameters
+};
+
+// Keeps the BalancingConfig in the mapping aligned for Eigen
+const size_t kConfigOffset = (sizeof(ConfigCacheHeader) + 15) & ~(size_t)15;
+
+//============================================================================
+// Adds the bytes at data to the FNV-1a hash
+void HashBytes(const void* data, size_t size, uint64_t* hash) {
+  const unsigned char* bytes = (const unsigned char*)data;
+  for (size_t i = 0; i < size; i++) {
+    *hash ^= bytes[i];
+    *hash *= 1099511628211ULL;
+  }
+}
+
+//============================================================================
+// Hash of the name, offset and size of every field of BalancingConfig, so
+// that a build in which fields were added, removed, reordered or retyped does
+// not read the cache of another even if sizeof(BalancingConfig) is the same.
+// New fields of BalancingConfig are to be listed here
+uint64_t ConfigLayout() {
+  BalancingConfig config;
+  uint64_t hash = 14695981039346656037ULL;
+#define LAYOUT_FIELD(field)                                              \
+  do {                                                                   \
+    uint64_t layout[2] = {                                               \
+        (uint64_t)((const char*)&config.field - (const char*)&config),   \
+        (uint64_t)sizeof(config.field)};                                 \
+    HashBytes(#field, sizeof(#field), &hash);                            \
+    HashBytes(layout, sizeof(layout), &hash);                            \
+  } while (0)
+  LAYOUT_FIELD(urdfpath);
+  LAYOUT_FIELD(comParametersPath);
+  LAYOUT_FIELD(pdGainsGroundLo);
+  LAYOUT_FIELD(pdGainsGroundHi);
+  LAYOUT_FIELD(pdGainsStand);
+  LAYOUT_FIELD(pdGainsSit);
+  LAYOUT_FIELD(pdGainsBalLo);
+  LAYOUT_FIELD(pdGainsBalHi);
+  LAYOUT_FIELD(joystickGainsGroundLo);
+  LAYOUT_FIELD(joystickGainsGroundHi);
+  LAYOUT_FIELD(joystickGainsStand);
+  LAYOUT_FIELD(joystickGainsSit);
+  LAYOUT_FIELD(joystickGainsBalLo);
+  LAYOUT_FIELD(joystickGainsBalHi);
+  LAYOUT_FIELD(dynamicLQR);
+  LAYOUT_FIELD(lqrQ);
+  LAYOUT_FIELD(lqrR);
+  LAYOUT_FIELD(lqrGainSource);
+  LAYOUT_FIELD(lqrGainTablePath);
+  LAYOUT_FIELD(lqrGainTableArmTolerance);
+  LAYOUT_FIELD(lqrGainCacheSize);
+  LAYOUT_FIELD(lqrGainCacheQuantum);
+  LAYOUT_FIELD(lqrRelinearizeTolerance);
+  LAYOUT_FIELD(lqrWarmStart);
+  LAYOUT_FIELD(imuSitAngle);
+  LAYOUT_FIELD(toBalThreshold);
+  LAYOUT_FIELD(startBalThresholdLo);
+  LAYOUT_FIELD(startBalThresholdHi);
+  LAYOUT_FIELD(waistHiLoThreshold);
+  LAYOUT_FIELD(manualArmLockUnlock);
+  LAYOUT_FIELD(controlRate);
+  LAYOUT_FIELD(upperBodyRateDivider);
+  LAYOUT_FIELD(sensorTimeStep);
+  LAYOUT_FIELD(dtFilterGain);
+  LAYOUT_FIELD(maxTimeStep);
+  LAYOUT_FIELD(joystickTimeoutMs);
+  LAYOUT_FIELD(flightRecorderPath);
+  LAYOUT_FIELD(flightRecorderCapacity);
+  LAYOUT_FIELD(inProcessSimulation);
+  LAYOUT_FIELD(reloadConfig);
+  LAYOUT_FIELD(rtPriority);
+  LAYOUT_FIELD(rtControlCpus);
+  LAYOUT_FIELD(rtAuxiliaryCpus);
+  LAYOUT_FIELD(rtLockMemory);
+  LAYOUT_FIELD(rtPrefaultStackKb);
+  LAYOUT_FIELD(rtPrefaultHeapKb);
+  LAYOUT_FIELD(is_simulation_);
+  LAYOUT_FIELD(sim_dt_);
+  LAYOUT_FIELD(sim_max_input_current_);
+#undef LAYOUT_FIELD
+  return hash;
+}
+
+//============================================================================
+// Fills key from the file at path. Returns false if it cannot be read
+bool ReadSourceKey(const char* path, SourceKey* key) {
+  memset(key, 0, sizeof(*key));
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  key->mtime_sec = st.st_mtim.tv_sec;
+  key->mtime_nsec = st.st_mtim.tv_nsec;
+  key->size = st.st_size;
+  key->hash = 14695981039346656037ULL;
+  if (st.st_size > 0) {
+    void* mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    HashBytes(mapping, st.st_size, &key->hash);
+    munmap(mapping, st.st_size);
+  }
+  close(fd);
+  return true;
+}
+
+//============================================================================
+bool SameKey(const SourceKey& a, const SourceKey& b) {
+  return a.mtime_sec == b.mtime_sec && a.mtime_nsec == b.mtime_nsec &&
+         a.size == b.size && a.hash == b.hash;
+}
+
+//============================================================================
+// Copies params and beta out of the cache at path if it is valid for the
+// current cfg file (config_key) and CoM parameters file
+bool LoadConfigCache(const std::string& path, const SourceKey& config_key,
+                     bool is_simulation, BalancingConfig* params,
+                     Eigen::MatrixXd* beta) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      (size_t)st.st_size < kConfigOffset + sizeof(BalancingConfig)) {
+    close(fd);
+    return false;
+  }
+  void* mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) return false;
+
+  // Written by this build for the same cfg file and mode
+  const ConfigCacheHeader* header = (const ConfigCacheHeader*)mapping;
+  const BalancingConfig* config =
+      (const BalancingConfig*)((const char*)mapping + kConfigOffset);
+  const double* beta_data = (const double*)(config + 1);
+  size_t beta_size = (size_t)header->beta_rows * header->beta_cols;
+  bool valid =
+      (memcmp(header->magic, kConfigCacheMagic, sizeof(header->magic)) == 0 &&
+       header->version == kConfigCacheVersion &&
+       header->config_size == sizeof(BalancingConfig) &&
+       header->config_layout == ConfigLayout() &&
+       (header->is_simulation != 0) == is_simulation &&
+       SameKey(header->config_key, config_key) &&
+       kConfigOffset + sizeof(BalancingConfig) + beta_size * sizeof(double) ==
+           (size_t)st.st_size);
+
+  // The CoM parameters did not change either
+  if (valid && strlen(config->comParametersPath) != 0) {
+    SourceKey beta_key;
+    valid = ReadSourceKey(config->comParametersPath, &beta_key) &&
+            SameKey(header->beta_key, beta_key);
+  }
+  if (valid) {
+    *params = *config;
+    *beta = Eigen::Map<const Eigen::MatrixXd>(beta_data, header->beta_rows,
+                                              header->beta_cols);
+  }
+  munmap(mapping, st.st_size);
+  return valid;
+}
+
+//============================================================================
+// Writes the cache at path through a temporary file, so that a cache is
+// never seen half written
+bool SaveConfigCache(const std::string& path, const SourceKey& config_key,
+                     const BalancingConfig& params,
+                     const Eigen::MatrixXd& beta) {
+  ConfigCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kConfigCacheMagic, sizeof(header.magic));
+  header.version = kConfigCacheVersion;
+  header.config_size = sizeof(BalancingConfig);
+  header.config_layout = ConfigLayout();
+  header.is_simulation = (params.is_simulation_ ? 1 : 0);
+  header.beta_rows = beta.rows();
+  header.beta_cols = beta.cols();
+  header.config_key = config_key;
+  if (strlen(params.comParametersPath) != 0 &&
+      !ReadSourceKey(params.comParametersPath, &header.beta_key)) {
+    return false;
+  }
+
+  std::string temp_path = path + ".tmp";
+  int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return false;
+  char padding[kConfigOffset - sizeof(header) + 1];
+  memset(padding, 0, sizeof(padding));
+  size_t beta_bytes = beta.size() * sizeof(double);
+  bool success =
+      (write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+       write(fd, padding, kConfigOffset - sizeof(header)) ==
+           (ssize_t)(kConfigOffset - sizeof(header)) &&
+       write(fd, &params, sizeof(params)) == (ssize_t)sizeof(params) &&
+       (beta_bytes == 0 ||
+        write(fd, beta.data(), beta_bytes) == (ssize_t)beta_bytes));
+  success = (close(fd) == 0) && success;
+  if (success) success = (rename(temp_path.c_str(), path.c_str()) == 0);
+  if (!success) remove(temp_path.c_str());
+  return success;
+}
+}  // namespace
+
+//============================================================================
+bool ReadConfigParamsCached(const char* config_file, BalancingConfig* params,
+                            Eigen::MatrixXd* beta) {
+  std::string cache_path = std::string(config_file) + ".cache";
+  SourceKey config_key;
+  bool has_key = ReadSourceKey(config_file, &config_key);
+  if (has_key && LoadConfigCache(cache_path, config_key,
+                                 params->is_simulation_, params, beta)) {
+    std::cout << "[INFO] config: read from " << cache_path << std::endl;
+    return true;
+  }
+
+  // Parse the text files
+  ReadConfigParams(config_file, params);
+  beta->resize(0, 0);
+  if (strlen(params->comParametersPath) != 0) {
+    try {
+      std::cout << "Reading converged beta ...\n";
+      *beta = readInputFileAsMatrix(params->comParametersPath);
+      std::cout << "|-> Done\n";
+    } catch (std::exception& e) {
+      std::cout << e.what() << std::endl;
+      assert(false && "Problem loading CoM parameters...");
+    }
+  }
+
+  if (!has_key || !SaveConfigCache(cache_path, config_key, *params, *beta)) {
+    std::cout << "[ERR ] config: could not write " << cache_path << ": "
+              << strerror(errno) << std::endl;
+  }
+  return false;
+}
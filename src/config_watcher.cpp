@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file config_watcher.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Reloads the gains and thresholds when the cfg file changes
+ */
+
+#include "balancing/config_watcher.h"
+
+#include <errno.h>        // errno
+#include <poll.h>         // poll()
+#include <pthread.h>      // pthread_create(), pthread_join()
+#include <string.h>       // strerror(), strncpy(), strrchr(), strcmp()
+#include <sys/inotify.h>  // inotify_init1(), inotify_add_watch()
+#include <unistd.h>       // read(), close()
+
+#include <iostream>  // std::cout, std::endl
+#include <string>    // std::string
+
+#include "balancing/balancing_config.h"  // BalancingConfig, TryReadConfigParams()
+#include "balancing/control.h"  // ControlTuning, GetControlTuning(), ComputeLqrHackRatios()
+
+/* ************************************************************************* */
+ConfigWatcher::ConfigWatcher(const char* config_file,
+                             const BalancingConfig& params,
+                             const Eigen::Matrix<double, 4, 4>& hack_A,
+                             const Eigen::Matrix<double, 4, 1>& hack_B)
+    : params_(params),
+      hack_A_(hack_A),
+      hack_B_(hack_B),
+      taken_version_(0),
+      inotify_fd_(-1),
+      num_rejected_(0),
+      running_(false) {
+  strncpy(config_file_, config_file, sizeof(config_file_) - 1);
+  config_file_[sizeof(config_file_) - 1] = '\0';
+  const char* slash = strrchr(config_file_, '/');
+  file_name_ = (slash != NULL ? slash + 1 : config_file_);
+}
+
+/* ************************************************************************* */
+ConfigWatcher::~ConfigWatcher() { Stop(); }
+
+/* ************************************************************************* */
+bool ConfigWatcher::Start() {
+  if (running_.load()) return true;
+
+  // Editors often write a new file and rename it over the old one, which
+  // only shows up as an event of the directory
+  std::string directory(config_file_, file_name_ - config_file_);
+  if (directory.empty()) directory = ".";
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0 ||
+      inotify_add_watch(inotify_fd_, directory.c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    std::cout << "[ERR ] config: cannot watch " << directory << ": "
+              << strerror(errno) << std::endl;
+    if (inotify_fd_ >= 0) close(inotify_fd_);
+    inotify_fd_ = -1;
+    return false;
+  }
+  std::cout << "[INFO] config: reloading gains and thresholds when "
+            << config_file_ << " changes" << std::endl;
+
+  running_.store(true);
+  pthread_create(&thread_, NULL, &ConfigWatcher::Run, this);
+  return true;
+}
+
+/* ************************************************************************* */
+void ConfigWatcher::Stop() {
+  if (!running_.load()) return;
+  running_.store(false);
+  pthread_join(thread_, NULL);
+  close(inotify_fd_);
+  inotify_fd_ = -1;
+}
+
+/* ************************************************************************* */
+bool ConfigWatcher::NewTuning(ControlTuning* tuning) {
+  if (tuning_.version() == taken_version_) return false;
+
+  // If the watcher is publishing right now, it is taken next time
+  unsigned long version;
+  if (!tuning_.TryLoad(tuning, &version)) return false;
+  taken_version_ = version;
+  return true;
+}
+
+/* ************************************************************************* */
+void ConfigWatcher::Reload() {
+  BalancingConfig params = params_;
+  ControlTuning tuning;
+  if (!TryReadConfigParams(config_file_, &params)) {
+    std::cout << "[ERR ] config: could not read " << config_file_
+              << ", keeping the gains in use" << std::endl;
+    num_rejected_.fetch_add(1);
+    return;
+  }
+  GetControlTuning(params, &tuning);
+  if (!ValidateControlTuning(tuning)) {
+    std::cout << "[ERR ] config: keeping the gains in use" << std::endl;
+    num_rejected_.fetch_add(1);
+    return;
+  }
+  if (!ComputeLqrHackRatios(hack_A_, hack_B_, &tuning)) {
+    std::cout << "[ERR ] config: no finite lqr hack ratios for these gains, "
+                 "keeping the gains in use"
+              << std::endl;
+    num_rejected_.fetch_add(1);
+    return;
+  }
+  params_ = params;
+  tuning_.Store(tuning);
+  std::cout << "[INFO] config: new gains and thresholds from the next "
+               "iteration on, other changes need a restart"
+            << std::endl;
+}
+
+/* ************************************************************************* */
+void* ConfigWatcher::Run(void* arg) {
+  ConfigWatcher* watcher = (ConfigWatcher*)arg;
+
+  // Wakes up now and then to see if it should stop
+  struct pollfd fd;
+  fd.fd = watcher->inotify_fd_;
+  fd.events = POLLIN;
+  char buffer[4096]
+      __attribute__((aligned(__alignof__(struct inotify_event))));
+  while (watcher->running_.load()) {
+    if (poll(&fd, 1, 200) <= 0) continue;
+
+    // All events read at once lead to one reload at most
+    bool changed = false;
+    ssize_t length;
+    while ((length = read(watcher->inotify_fd_, buffer, sizeof(buffer))) >
+           0) {
+      for (char* p = buffer; p < buffer + length;) {
+        const struct inotify_event* event = (const struct inotify_event*)p;
+        if (event->len > 0 && strcmp(event->name, watcher->file_name_) == 0)
+          changed = true;
+        p += sizeof(struct inotify_event) + event->len;
+      }
+    }
+    if (changed) watcher->Reload();
+  }
+  return NULL;
+}
@@ -44,29 +44,43 @@
 
 #include <algorithm>  // std::max(), std::min()
 #include <cmath>      // atan2, tan
-#include <cstring>    // strlen
+#include <cstring>    // strlen, strcmp, memset
 #include <iostream>   // std::cout, std::endl
 #include <string>     // std::string
+#include <vector>     // std::vector
 
 #include <amino/time.h>  // aa_tm: _now(), _timespec2sec(), _sub()
 #include <Eigen/Eigen>  // Eigen:: MatrixXd, VectorXd, Vector3d, Matrix<double, #, #>
 #include <dart/dart.hpp>             // dart::dynamics::SkeletonPtr
-#include <kore.hpp>                  // Krang::Hardware
 #include <krang-utils/file_ops.hpp>  // readInputFileAsMatrix()
-#include <krang-utils/linearize_wip.hpp>  // linearize_wip::ComputeLinearizedDynamics()
-#include <krang-utils/lqr.hpp>            // lqr()
 
+#include "balancing/alloc_guard.h"  // AllocGuardEnabled()
 #include "balancing/balancing_config.h"  // BalancingConfig
+#include "balancing/com_engine.h"  // ComEngine
+#include "balancing/com_evaluator.h"  // ComEvaluator
+#include "balancing/hardware_interface.h"  // HardwareInterface
+#include "balancing/lqr_gain_cache.h"  // LqrGainCache
+#include "balancing/lqr_gains.h"  // ComputeLqrGains(), LinearizeWip(), LqrGainTable
+#include "balancing/lqr_worker.h"  // LqrWorker
+#include "balancing/sensors.h"    // kWaistDof, kTorsoDof
 
 //============================================================================
 const char BalanceControl::MODE_STRINGS[][16] = {
     "Ground Lo", "Stand", "Sit", "Bal Lo", "Bal Hi", "Ground Hi"};
 
 //============================================================================
-BalanceControl::BalanceControl(Krang::Hardware* krang,
+BalanceControl::BalanceControl(HardwareInterface* hw,
                                dart::dynamics::SkeletonPtr robot,
-                               BalancingConfig& params)
-    : krang_(krang), robot_(robot), is_simulation_(params.is_simulation_) {
+                               BalancingConfig& params,
+                               const Eigen::MatrixXd* beta)
+    : hw_(hw),
+      robot_(robot),
+      com_engine_(robot, std::vector<std::string>{"LWheel", "RWheel"}),
+      sensor_time_step_(params.sensorTimeStep),
+      dt_estimator_(
+          (params.controlRate > 0.0 ? 1.0 / params.controlRate : 0.01),
+          params.dtFilterGain, params.maxTimeStep),
+      is_simulation_(params.is_simulation_) {
   // if in simulation mode dt = sim_dt, if not then 0.001 only until first
   // iteration begins
   dt_ = (is_simulation_? params.sim_dt_ : 0.01);
@@ -81,6 +95,25 @@ BalanceControl::BalanceControl(Krang::Hardware* krang,
   lqrQ_ = params.lqrQ;
   lqrR_ = params.lqrR;
 
+  // LQR gains solved on a separate thread, started below once the robot has
+  // its CoM parameters
+  lqr_worker_ = NULL;
+  lqr_gain_age_ = 0.0;
+
+  // Online LQR gains are reused while the pose that matters to the
+  // linearization stays close to the one they were solved for
+  relinearize_tolerance_ = params.lqrRelinearizeTolerance;
+  lqr_warm_start_ = params.lqrWarmStart;
+  has_linearization_ = false;
+  num_linearizations_ = num_linearization_reuses_ = 0;
+
+  // Online LQR gains of recent upper body poses
+  lqr_gain_cache_ = NULL;
+  if (dynamic_lqr_ && params.lqrGainCacheSize > 0) {
+    lqr_gain_cache_ = new LqrGainCache(params.lqrGainCacheSize,
+                                       params.lqrGainCacheQuantum);
+  }
+
   // PD Gains for all modes
   pd_gains_list_[BalanceControl::GROUND_LO] = params.pdGainsGroundLo;
   pd_gains_list_[BalanceControl::GROUND_HI] = params.pdGainsGroundHi;
@@ -119,38 +152,157 @@ BalanceControl::BalanceControl(Krang::Hardware* krang,
   error_.setZero();
   joystick_forw = 0.0;
   joystick_spin = 0.0;
+  control_input_[0] = control_input_[1] = 0.0;
+  memset(&sensors_, 0, sizeof(sensors_));
+  stood_up_timer_ = 0;
+  assert(robot_->getNumDofs() <= (size_t)kMaxSensorDofs &&
+         "Skeleton has more dofs than a SensorSample can hold");
 
   // Read CoM estimation model paramters
-  if (strlen(params.comParametersPath) != 0) {
-    Eigen::MatrixXd beta;
+  com_parameters_hash_ = HashComParameters(Eigen::MatrixXd());
+  if (beta != NULL) {
+    if (beta->size() != 0) BalanceControl::SetComParameters(*beta, 4);
+    com_parameters_hash_ = HashComParameters(*beta);
+  } else if (strlen(params.comParametersPath) != 0) {
+    Eigen::MatrixXd beta_params;
     std::string inputBetaFilename = params.comParametersPath;
     try {
       std::cout << "Reading converged beta ...\n";
-      beta = readInputFileAsMatrix(inputBetaFilename);
+      beta_params = readInputFileAsMatrix(inputBetaFilename);
       std::cout << "|-> Done\n";
     } catch (exception& e) {
       std::cout << e.what() << std::endl;
       assert(false && "Problem loading CoM parameters...");
     }
-    BalanceControl::SetComParameters(beta, 4);
+    BalanceControl::SetComParameters(beta_params, 4);
+    com_parameters_hash_ = HashComParameters(beta_params);
+  }
+
+  // LQR gains interpolated from a precomputed table instead of solved online,
+  // while the arms are where they were when it was computed
+  use_lqr_gain_table_ = false;
+  num_table_misses_ = 0;
+  table_arm_tolerance_ = params.lqrGainTableArmTolerance;
+  if (dynamic_lqr_ && strcmp(params.lqrGainSource, "table") == 0) {
+    use_lqr_gain_table_ =
+        lqr_gain_table_.Load(params.lqrGainTablePath) &&
+        lqr_gain_table_.Matches(is_simulation_, lqrQ_, lqrR_,
+                                com_parameters_hash_);
+    if (!use_lqr_gain_table_)
+      std::cout << "[ERR ] Falling back to online lqr gains" << std::endl;
+  }
+
+  // CoM evaluated in closed form from the joint angles, if it agrees with
+  // dart at the initial pose
+  use_com_evaluator_ =
+      com_evaluator_.Compile(robot_, std::vector<std::string>{"LWheel",
+                                                              "RWheel"});
+  if (use_com_evaluator_) {
+    double q[kMaxSensorDofs];
+    for (size_t i = 0; i < robot_->getNumDofs(); i++)
+      q[i] = robot_->getPosition(i);
+    double error = (com_evaluator_.Com(q) - GetBodyCom(robot_)).norm();
+    if (error > 1e-9) {
+      std::cout << "[ERR ] Closed-form com is off by " << error
+                << " m, using dart" << std::endl;
+      use_com_evaluator_ = false;
+    }
+  }
+
+  // Online LQR gains linearized in closed form from the lumped parameters of
+  // the closed-form com, if they agree with dart at the initial pose
+  use_wip_model_ = false;
+  if (dynamic_lqr_ && use_com_evaluator_ && InitWipParameters()) {
+    Eigen::Matrix<double, 4, 4> A;
+    Eigen::Matrix<double, 4, 1> B;
+    ComputeWipParameters();
+    LinearizeWip(wip_, &A, &B);
+    Eigen::MatrixXd A_dart = Eigen::MatrixXd::Zero(4, 4);
+    Eigen::MatrixXd B_dart = Eigen::MatrixXd::Zero(4, 1);
+    LinearizeWip(robot_, is_simulation_, &A_dart, &B_dart);
+    double error = std::max(
+        (A - A_dart).cwiseAbs().maxCoeff() / A_dart.cwiseAbs().maxCoeff(),
+        (B - B_dart).cwiseAbs().maxCoeff() / B_dart.cwiseAbs().maxCoeff());
+    if (error > 1e-6) {
+      std::cout << "[ERR ] Closed-form linearization is off by " << error
+                << " (relative), using dart" << std::endl;
+    } else {
+      use_wip_model_ = true;
+    }
+  }
+
+  // The dart linearization allocates inside dart and krang-utils, which the
+  // alloc guard would catch in every iteration that solves lqr gains. Builds
+  // with the guard only solve them from the closed-form linearization
+  if (dynamic_lqr_ && !use_wip_model_ && AllocGuardEnabled()) {
+    std::cout << "[ERR ] Alloc guard is on but there is no closed-form "
+                 "linearization, using the fixed lqr gains"
+              << std::endl;
+    dynamic_lqr_ = false;
   }
 
   // time
   t_prev_ = aa_tm_now();
 
   // To correctly do ComputeLqrGains()
-  UpdateState();
-
-  // LQR Hack Ratios
-  Eigen::VectorXd lqrGains = Eigen::VectorXd::Zero(4);
+  if (hw_ != NULL)
+    UpdateState();
+  else
+    ComputeState();
+
+  // LQR Hack Ratios. The linearization at the startup pose is kept so that
+  // they can be computed again for other costs or STAND gains on a reload
+  if (use_wip_model_) {
+    ComputeWipParameters();
+    LinearizeWip(wip_, &hack_A_, &hack_B_);
+  } else {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(4, 4);
+    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(4, 1);
+    LinearizeWip(robot_, is_simulation_, &A, &B);
+    hack_A_ = A;
+    hack_B_ = B;
+  }
+  ControlTuning tuning;
+  GetControlTuning(params, &tuning);
+  ComputeLqrHackRatios(hack_A_, hack_B_, &tuning);
   lqr_hack_ratios_ = Eigen::Matrix<double, 4, 4>::Identity();
-  lqrGains = BalanceControl::ComputeLqrGains();
-  for (int i = 0; i < lqr_hack_ratios_.cols(); i++) {
-    lqr_hack_ratios_(i, i) =
-        pd_gains_list_[BalanceControl::STAND](i) / -lqrGains(i);
+  for (int i = 0; i < 4; i++)
+    lqr_hack_ratios_(i, i) = tuning.lqr_hack_ratios[i];
+
+  // LQR gains solved on a separate thread for the latest pose. Until the
+  // first solution is ready they are solved in the control loop. The worker
+  // clones robot_, so it is only created once the CoM parameters have been
+  // applied, and after the hack ratios so that those are always computed
+  // from gains solved here
+  if (dynamic_lqr_ && strcmp(params.lqrGainSource, "background") == 0) {
+    lqr_worker_ = new LqrWorker(robot_, is_simulation_, lqrQ_, lqrR_);
+    lqr_worker_->Start();
   }
 }
 
+//============================================================================
+BalanceControl::~BalanceControl() {
+  if (lqr_worker_ != NULL) {
+    std::cout << "lqr worker solves: " << lqr_worker_->num_solves()
+              << std::endl;
+    delete lqr_worker_;
+  }
+  if (lqr_gain_cache_ != NULL) {
+    std::cout << "lqr gain cache hits: " << lqr_gain_cache_->hits()
+              << ", misses: " << lqr_gain_cache_->misses() << std::endl;
+    delete lqr_gain_cache_;
+  }
+  if (dynamic_lqr_) {
+    std::cout << "lqr linearizations: " << num_linearizations_
+              << ", reused: " << num_linearization_reuses_ << std::endl;
+  }
+  if (use_lqr_gain_table_) {
+    std::cout << "iterations with the arms off the lqr gain table: "
+              << num_table_misses_ << std::endl;
+  }
+  if (dt_estimator_.num_samples() > 0) dt_estimator_.PrintStats();
+}
+
 //============================================================================
 double BalanceControl::ElapsedTimeSinceLastCall() {
   t_now_ = aa_tm_now();
@@ -160,6 +312,12 @@ double BalanceControl::ElapsedTimeSinceLastCall() {
   return dt_;
 }
 
+//============================================================================
+double BalanceControl::SetTimeStep(double dt) {
+  dt_ = dt;
+  return dt_;
+}
+
 //============================================================================
 Eigen::Vector3d BalanceControl::GetBodyCom(dart::dynamics::SkeletonPtr robot) {
   dart::dynamics::BodyNodePtr lwheel = robot->getBodyNode("LWheel");
@@ -171,32 +329,130 @@ Eigen::Vector3d BalanceControl::GetBodyCom(dart::dynamics::SkeletonPtr robot) {
          (full_mass - 2 * wheel_mass);
 }
 
+//============================================================================
+bool BalanceControl::InitWipParameters() {
+  dart::dynamics::BodyNodePtr wheels[2] = {robot_->getBodyNode("LWheel"),
+                                           robot_->getBodyNode("RWheel")};
+  const Eigen::Isometry3d& root = robot_->getBodyNode(0)->getWorldTransform();
+  wip_.motor = WipMotorParameters(is_simulation_);
+  wip_.wheel_mass = wip_.wheel_inertia = 0.0;
+  Eigen::Vector3d axle_point = Eigen::Vector3d::Zero();
+  Eigen::Vector3d axle_axis = Eigen::Vector3d::Zero();
+  for (int i = 0; i < 2; i++) {
+    dart::dynamics::Joint* joint = wheels[i]->getParentJoint();
+    if (joint->getType() != dart::dynamics::RevoluteJoint::getStaticType()) {
+      std::cout << "[ERR ] " << wheels[i]->getName()
+                << " does not have a revolute joint" << std::endl;
+      return false;
+    }
+
+    // Axle in the frame of the wheel, through the origin of its joint
+    const Eigen::Isometry3d& joint_in_wheel =
+        joint->getTransformFromChildBodyNode();
+    Eigen::Vector3d axis =
+        joint_in_wheel.linear() *
+        static_cast<dart::dynamics::RevoluteJoint*>(joint)->getAxis();
+    Eigen::Vector3d offset =
+        wheels[i]->getLocalCOM() - joint_in_wheel.translation();
+    wip_.wheel_mass += wheels[i]->getMass();
+    wip_.wheel_inertia +=
+        axis.dot(wheels[i]->getInertia().getMoment() * axis) +
+        wheels[i]->getMass() * offset.cross(axis).squaredNorm();
+
+    // The same in the world
+    const Eigen::Isometry3d& wheel = wheels[i]->getWorldTransform();
+    axle_point += 0.5 * (wheel * joint_in_wheel.translation());
+    axle_axis += wheel.linear() * axis;
+  }
+
+  // The axle moves with the root body, whose world transform ComEvaluator
+  // keeps
+  axle_point_ = root.linear().transpose() * (axle_point - root.translation());
+  axle_axis_ = root.linear().transpose() * axle_axis.normalized();
+  return true;
+}
+
+//============================================================================
+void BalanceControl::ComputeWipParameters() {
+  const Eigen::Matrix3d& root = com_evaluator_.root_rotation();
+  Eigen::Vector3d axis = root * axle_axis_;
+  Eigen::Vector3d point = root * axle_point_ + com_evaluator_.root_translation();
+
+  // Distance of the com from the axle
+  Eigen::Vector3d arm = com_evaluator_.com() - point;
+  wip_.body_mass = com_evaluator_.mass();
+  wip_.com_distance = (arm - arm.dot(axis) * axis).norm();
+  wip_.body_inertia = com_evaluator_.InertiaAbout(point, axis);
+}
+
 //============================================================================
 void BalanceControl::UpdateState() {
-  // Read motor encoders, imu and ft and update dart skeleton
-  krang_->updateSensors(dt_);
+  // Read motor encoders, imu and ft and update dart skeleton. The readings
+  // are kept for the rest of the iteration
+  hw_->ReadSensors(dt_, &sensors_);
+
+  // The jitter of the sensor timestamps is measured in any case, and only
+  // used as the time step with sensorTimeStep
+  double sensor_dt = dt_estimator_.Update(sensors_.time);
+  if (sensor_time_step_) dt_ = sensor_dt;
 
-  // Calculate the COM Using Skeleton
-  com_ = GetBodyCom(robot_) - robot_->getPositions().segment(3, 3);
+  ComputeState();
+}
+
+//============================================================================
+void BalanceControl::UpdateState(const SensorSample& sample) {
+  sensors_ = sample;
+  for (int i = 0; i < sample.num_dofs; i++)
+    robot_->setPosition(i, sample.q[i]);
+
+  ComputeState();
+}
+
+//============================================================================
+void BalanceControl::ComputeState() {
+  // Calculate the COM Using Skeleton. The positions are read dof by dof
+  // because getPositions() would copy all dofs into a heap vector
+  if (use_com_evaluator_) {
+    double q[kMaxSensorDofs];
+    for (size_t i = 0; i < robot_->getNumDofs(); i++)
+      q[i] = robot_->getPosition(i);
+    com_ = com_evaluator_.Com(q) - Eigen::Vector3d(q[3], q[4], q[5]);
+  } else {
+    com_ = com_engine_.Com() - Eigen::Vector3d(robot_->getPosition(3),
+                                                 robot_->getPosition(4),
+                                                 robot_->getPosition(5));
+  }
 
   // Update the state (note for amc we are reversing the effect of the motion of
   // the upper body) State are theta, dtheta, x, dx, psi, dpsi
   state_(0) = atan2(com_(0), com_(2));  // - 0.3 * M_PI / 180.0;;
-  state_(1) = krang_->imuSpeed;
-  state_(2) = (krang_->amc->pos[0] + krang_->amc->pos[1]) / 2.0 + krang_->imu;
+  state_(1) = sensors_.imu_speed;
+  state_(2) = (sensors_.amc_pos[0] + sensors_.amc_pos[1]) / 2.0 + sensors_.imu;
   state_(3) =
-      (krang_->amc->vel[0] + krang_->amc->vel[1]) / 2.0 + krang_->imuSpeed;
-  state_(4) = (krang_->amc->pos[1] - krang_->amc->pos[0]) / 2.0;
-  state_(5) = (krang_->amc->vel[1] - krang_->amc->vel[0]) / 2.0;
+      (sensors_.amc_vel[0] + sensors_.amc_vel[1]) / 2.0 + sensors_.imu_speed;
+  state_(4) = (sensors_.amc_pos[1] - sensors_.amc_pos[0]) / 2.0;
+  state_(5) = (sensors_.amc_vel[1] - sensors_.amc_vel[0]) / 2.0;
 
   // Making adjustment in com to make it consistent with the hack above for
   // state(0)
   com_(0) = com_(2) * tan(state_(0));
+
+  // Let the lqr worker solve for the new pose
+  if (lqr_worker_ != NULL && sensors_.num_dofs > 0)
+    lqr_worker_->PublishPose(sensors_.q, sensors_.num_dofs);
 }
 
 //============================================================================
 void BalanceControl::SetComParameters(Eigen::MatrixXd beta_params,
                                       int num_body_params) {
+  ApplyComParameters(beta_params, num_body_params, robot_);
+  com_engine_.UpdateMassProperties();
+}
+
+//============================================================================
+void ApplyComParameters(const Eigen::MatrixXd& beta_params,
+                        int num_body_params,
+                        dart::dynamics::SkeletonPtr robot) {
   Eigen::Vector3d bodyMCOM;
   double mi;
   int numBodies = beta_params.cols() / num_body_params;
@@ -207,8 +463,8 @@ void BalanceControl::SetComParameters(Eigen::MatrixXd beta_params,
     bodyMCOM(2) = beta_params(0, i * num_body_params + 3);
 
     // std::cout << robot->getBodyNode(i)->getName() << std::endl;
-    robot_->getBodyNode(i)->setMass(mi);
-    robot_->getBodyNode(i)->setLocalCOM(bodyMCOM / mi);
+    robot->getBodyNode(i)->setMass(mi);
+    robot->getBodyNode(i)->setLocalCOM(bodyMCOM / mi);
   }
 }
 
@@ -268,48 +524,63 @@ void BalanceControl::ComputeCurrent(const Eigen::Matrix<double, 6, 1>& pd_gain,
   control_input[1] =
       std::max(-max_input_current_,
                std::min(max_input_current_, u_theta_ + u_x_ - u_spin_));
+  control_input_[0] = control_input[0];
+  control_input_[1] = control_input[1];
 }
 
 //============================================================================
-Eigen::MatrixXd BalanceControl::ComputeLqrGains() {
-  // TODO: Get rid of dynamic allocation
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(4, 4);
-  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(4, 1);
-  Eigen::VectorXd B_thWheel = Eigen::VectorXd::Zero(3);
-  Eigen::VectorXd B_thCOM = Eigen::VectorXd::Zero(3);
-  Eigen::VectorXd LQR_Gains = Eigen::VectorXd::Zero(4);
-
-  // Find linearized model of the WIP
-  linearize_wip::ParametersNotFoundInUrdf params;
-  if (is_simulation_) {
-    params.rotor_inertia = 0.0;
-    params.gear_ratio = 1;
-    params.wheel_radius = 0.25;
-  } else {
-    const double kKilogramMeterSquaredPerOunceInchSecondSquared = 0.00706154;
-    params.rotor_inertia =
-        0.022656 * kKilogramMeterSquaredPerOunceInchSecondSquared;
-    params.gear_ratio = 15;
-    params.wheel_radius = 0.25;
-  }
-  linearize_wip::ComputeLinearizedDynamics(krang_->robot, params, A, B);
-
-  // Apply lqr on the linearized model
-  lqr(A, B, lqrQ_, lqrR_, LQR_Gains);
-
-  const double motor_constant = 12.0 * 0.00706155183333;
-  const double gear_ratio = 15;
-  LQR_Gains /= (gear_ratio * motor_constant);
-  if (is_simulation_) {
-    // LQR gains are calculated using a model that has one wheel
-    // The torque needs to be distributed to either wheel, so needs
-    // to be halved
-    LQR_Gains = 0.5 * LQR_Gains;
+Eigen::Matrix<double, 4, 1> BalanceControl::ComputeLqrGains() {
+  Eigen::Matrix<double, 4, 1> LQR_Gains;
+  if (use_lqr_gain_table_ && ArmsAtTablePose()) {
+    lqr_gain_table_.Lookup(robot_->getPosition(kWaistDof),
+                           robot_->getPosition(kTorsoDof), &LQR_Gains);
+  } else if (lqr_worker_ != NULL &&
+             lqr_worker_->LatestGains(&LQR_Gains, &lqr_gain_age_)) {
+    // Solved on the worker thread for a pose lqr_gain_age_ seconds old
+  } else if (LinearizationValid()) {
+    // Neither A nor B of the linearization would change noticeably
+    LQR_Gains = lin_gains_;
+    num_linearization_reuses_++;
   } else {
+    // Upper body poses seen recently are looked up instead of solved again
+    LqrGainCache::Key key;
+    if (lqr_gain_cache_ != NULL) {
+      double pose[LqrGainCache::kPoseSize];
+      pose[0] = robot_->getPosition(kWaistDof);
+      pose[1] = robot_->getPosition(kTorsoDof);
+      for (int i = 0; i < 7; i++) {
+        pose[2 + i] = robot_->getPosition(kArmDof[0] + i);
+        pose[9 + i] = robot_->getPosition(kArmDof[1] + i);
+      }
+      lqr_gain_cache_->MakeKey(pose, &key);
+    }
+    if (lqr_gain_cache_ == NULL || !lqr_gain_cache_->Lookup(key, &LQR_Gains)) {
+      if (!lqr_warm_start_) riccati_.Reset();
+      if (use_wip_model_) {
+        Eigen::Matrix<double, 4, 4> A;
+        Eigen::Matrix<double, 4, 1> B;
+        ComputeWipParameters();
+        LinearizeWip(wip_, &A, &B);
+        SolveLqrGains(A, B, lqrQ_, lqrR_, &LQR_Gains, &riccati_);
+      } else {
+        ::ComputeLqrGains(robot_, is_simulation_, lqrQ_, lqrR_, &LQR_Gains,
+                          &riccati_);
+      }
+      if (lqr_gain_cache_ != NULL) lqr_gain_cache_->Insert(key, LQR_Gains);
+      num_linearizations_++;
+    }
+
+    // Pose of this linearization
+    for (size_t i = kWaistDof; i < robot_->getNumDofs(); i++)
+      lin_pose_[i] = robot_->getPosition(i);
+    lin_gains_ = LQR_Gains;
+    has_linearization_ = true;
+  }
+
+  if (!is_simulation_) {
     // TODO: LQR gains were calculated with only single wheel torque
     // They should be halved to divide between two wheels.
     // This may end up having to find lqr_hack_ratios_
-		LQR_Gains = 0.5 * LQR_Gains;
     LQR_Gains = lqr_hack_ratios_ * LQR_Gains;
   }
 
@@ -317,197 +588,445 @@ Eigen::MatrixXd BalanceControl::ComputeLqrGains() {
 }
 
 //============================================================================
-void BalanceControl::BalancingController(double* control_input) {
+bool BalanceControl::ArmsAtTablePose() {
+  double arm_pose[14];
+  for (int i = 0; i < 7; i++) {
+    arm_pose[i] = robot_->getPosition(kArmDof[0] + i);
+    arm_pose[7 + i] = robot_->getPosition(kArmDof[1] + i);
+  }
+  bool at_pose = lqr_gain_table_.ArmsAtPose(arm_pose, table_arm_tolerance_);
+  if (!at_pose) num_table_misses_++;
+  return at_pose;
+}
+
+//============================================================================
+bool BalanceControl::LinearizationValid() const {
+  if (!has_linearization_) return false;
+
+  // The base and wheels (the dofs before the waist) do not change the
+  // linearized dynamics
+  for (size_t i = kWaistDof; i < robot_->getNumDofs(); i++) {
+    if (fabs(robot_->getPosition(i) - lin_pose_[i]) > relinearize_tolerance_)
+      return false;
+  }
+  return true;
+}
+
+//============================================================================
+// Compile-time properties of the controller of each mode. kGainMask has bit i
+// set if gain i of the mode (th, dth, x, dx, psi, dpsi) is used, the others
+// being zero. kJoystick: joystick references move the robot. kDynamicLqr:
+// the first four gains are the online lqr gains if dynamicLQR is set.
+// kImuError: the theta error is that of the imu from the sit angle
+template <BalanceControl::BalanceMode mode>
+struct ModePolicy;
+
+template <>
+struct ModePolicy<BalanceControl::GROUND_LO> {
+  static const int kGainMask = 0x3c;  // fwd and spin only
+  static const bool kJoystick = true;
+  static const bool kDynamicLqr = false;
+  static const bool kImuError = false;
+};
+
+template <>
+struct ModePolicy<BalanceControl::GROUND_HI> {
+  static const int kGainMask = 0x3c;  // fwd and spin only
+  static const bool kJoystick = true;
+  static const bool kDynamicLqr = false;
+  static const bool kImuError = false;
+};
+
+template <>
+struct ModePolicy<BalanceControl::STAND> {
+  static const int kGainMask = 0x0f;  // no spinning
+  static const bool kJoystick = false;
+  static const bool kDynamicLqr = true;
+  static const bool kImuError = false;
+};
+
+template <>
+struct ModePolicy<BalanceControl::SIT> {
+  static const int kGainMask = 0x03;  // theta only
+  static const bool kJoystick = false;
+  static const bool kDynamicLqr = false;
+  static const bool kImuError = true;
+};
+
+template <>
+struct ModePolicy<BalanceControl::BAL_LO> {
+  static const int kGainMask = 0x3f;
+  static const bool kJoystick = true;
+  static const bool kDynamicLqr = true;
+  static const bool kImuError = false;
+};
+
+template <>
+struct ModePolicy<BalanceControl::BAL_HI> {
+  static const int kGainMask = 0x3f;
+  static const bool kJoystick = true;
+  static const bool kDynamicLqr = true;
+  static const bool kImuError = false;
+};
+
+//============================================================================
+// Modes without transitions of their own
+template <BalanceControl::BalanceMode mode>
+void BalanceControl::ModeTransition() {}
+
+//============================================================================
+template <>
+void BalanceControl::ModeTransition<BalanceControl::GROUND_LO>() {
+  // If the waist has been opened too much switch to GROUND_HI mode
+  if ((sensors_.waist_pos[0] - sensors_.waist_pos[1]) / 2.0 <
+      waist_hi_lo_threshold_ * M_PI / 180.0) {
+    balance_mode_ = BalanceControl::GROUND_HI;
+  }
+}
+
+//============================================================================
+template <>
+void BalanceControl::ModeTransition<BalanceControl::GROUND_HI>() {
+  // If waist angle decreases below waist_hi_lo_threshold_ goto groundLo mode
+  if ((sensors_.waist_pos[0] - sensors_.waist_pos[1]) / 2.0 >
+      waist_hi_lo_threshold_ * M_PI / 180.0) {
+    balance_mode_ = BalanceControl::GROUND_LO;
+  }
+}
+
+//============================================================================
+template <>
+void BalanceControl::ModeTransition<BalanceControl::STAND>() {
+  // If stood up go to balancing mode. Stand up condition is defined as base
+  // in the air and stopped moving. Former is determined by imu and latter by
+  // state(1), and has to hold for kStoodUpTimerLimit iterations
+  const int kStoodUpTimerLimit = 100;
+  const double kImuSitAngle = ((imu_sit_angle_ / 180.0) * M_PI);
+  if (sensors_.imu > kImuSitAngle && fabs(state_(1)) < to_bal_threshold_) {
+    stood_up_timer_++;
+  } else {
+    stood_up_timer_ = 0;
+  }
+  if (stood_up_timer_ > kStoodUpTimerLimit) {
+    balance_mode_ = BalanceControl::BAL_LO;
+  }
+}
+
+//============================================================================
+template <>
+void BalanceControl::ModeTransition<BalanceControl::SIT>() {
+  // If sat down switch to Ground Lo Mode
+  const double kImuSitAngle = ((imu_sit_angle_ / 180.0) * M_PI);
+  if (sensors_.imu < kImuSitAngle) {
+    std::cout << "imu (" << sensors_.imu << ") < limit (" << kImuSitAngle
+              << "):";
+    std::cout << "changing to Ground Lo Mode" << std::endl;
+    balance_mode_ = BalanceControl::GROUND_LO;
+  }
+}
+
+//============================================================================
+template <BalanceControl::BalanceMode mode>
+void BalanceControl::ModeController(double* control_input) {
+  typedef ModePolicy<mode> Policy;
+
   // The timer we use for deciding whether krang_ has stood up and needs to
   // be switched to BAL_LO mode. This timer is supposed to be zero in all
   // other modes excepts STAND mode. This is to ensure that no matter how we
   // transitioned to STAND mode, this timer is zero in the beginning.
-  // In STAND mode this timer starts running if robot is balancing. After it
-  // crosses the TimerLimit, mode is switched to balancing.
-  static int stood_up_timer = 0;
-  const int kStoodUpTimerLimit = 100;
-  if (balance_mode_ != BalanceControl::STAND) stood_up_timer = 0;
-
-  // Controllers for each mode
-  pd_gains_.setZero();
-  switch (balance_mode_) {
-    case BalanceControl::GROUND_LO: {
-      //  Update Reference
-      double forw, spin;
-      forw = joystick_gains_list_[BalanceControl::GROUND_LO][0] * joystick_forw;
-      spin = joystick_gains_list_[BalanceControl::GROUND_LO][1] * joystick_spin;
-      BalanceControl::UpdateReference(forw, spin);
-
-      // Calculate state Error
-      error_ = state_ - ref_state_;
-
-      // Gains - read fwd and spin only
-      pd_gains_.tail(4) = pd_gains_list_[BalanceControl::GROUND_LO].tail(4);
-
-      // Compute the current
-      BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
-
-      // State Transition - If the waist has been opened too much switch to
-      // GROUND_HI mode
-      if ((krang_->waist->pos[0] - krang_->waist->pos[1]) / 2.0 <
-          waist_hi_lo_threshold_ * M_PI / 180.0) {
-        balance_mode_ = BalanceControl::GROUND_HI;
-      }
+  if (mode != BalanceControl::STAND) stood_up_timer_ = 0;
 
-      break;
-    }
-    case BalanceControl::GROUND_HI: {
-      //  Update Reference
-      double forw, spin;
-      forw = joystick_gains_list_[BalanceControl::GROUND_HI][0] * joystick_forw;
-      spin = joystick_gains_list_[BalanceControl::GROUND_HI][1] * joystick_spin;
-      BalanceControl::UpdateReference(forw, spin);
-
-      // Calculate state Error
-      error_ = state_ - ref_state_;
-
-      // Gains - read fwd and spin gains only
-      pd_gains_.tail(4) = pd_gains_list_[BalanceControl::GROUND_HI].tail(4);
-
-      // Compute the current
-      BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
-
-      // State Transitions
-      // If in ground Hi mode and waist angle decreases below waist_hi_lo_threshold_ goto
-      // groundLo mode
-      if ((krang_->waist->pos[0] - krang_->waist->pos[1]) / 2.0 >
-          waist_hi_lo_threshold_ * M_PI / 180.0) {
-        balance_mode_ = BalanceControl::GROUND_LO;
-      }
-      break;
-    }
-    case BalanceControl::STAND: {
-      //  Update Reference
-      double forw, spin;
-      forw = 0.0;
-      spin = 0.0;
-      BalanceControl::UpdateReference(forw, spin);
-
-      // Calculate state Error
-      error_ = state_ - ref_state_;
-
-      // Gains - no spinning
-      pd_gains_.head(4) = pd_gains_list_[BalanceControl::STAND].head(4);
-      if (dynamic_lqr_ == true) {
-        Eigen::MatrixXd LQR_Gains;
-        LQR_Gains = BalanceControl::ComputeLqrGains();
-        pd_gains_.head(4) = -LQR_Gains;
-      }
+  //  Update Reference
+  double forw = 0.0, spin = 0.0;
+  if (Policy::kJoystick) {
+    forw = joystick_gains_list_[mode][0] * joystick_forw;
+    spin = joystick_gains_list_[mode][1] * joystick_spin;
+  }
+  BalanceControl::UpdateReference(forw, spin);
+
+  // Calculate state Error
+  error_ = state_ - ref_state_;
+  if (Policy::kImuError)
+    error_(0) = sensors_.imu - ((imu_sit_angle_ / 180.0) * M_PI);
+
+  // Gains of the mode, the unused ones zero
+  for (int i = 0; i < 6; i++)
+    pd_gains_(i) = (((Policy::kGainMask >> i) & 1) ? pd_gains_list_[mode](i)
+                                                    : 0.0);
+  if (Policy::kDynamicLqr && dynamic_lqr_) {
+    pd_gains_.head(4) = -BalanceControl::ComputeLqrGains();
+  }
 
-      // Compute the current
-      BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
+  // Compute the current
+  BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
 
-      // State Transition - If stood up go to balancing mode
-      // Stand up condition is defined as base in the air and stopped moving
-      // Former is determined by imu and latter by state(1)
-      const double kImuSitAngle = ((imu_sit_angle_ / 180.0) * M_PI);
-      if (krang_->imu > kImuSitAngle && fabs(state_(1)) < to_bal_threshold_) {
-        stood_up_timer++;
-      } else {
-        stood_up_timer = 0;
-      }
-      if (stood_up_timer > kStoodUpTimerLimit) {
-        balance_mode_ = BalanceControl::BAL_LO;
-      }
+  BalanceControl::ModeTransition<mode>();
+}
 
-      break;
-    }
-    case BalanceControl::BAL_LO: {
-      //  Update Reference
-      double forw, spin;
-      forw = joystick_gains_list_[BalanceControl::BAL_LO][0] * joystick_forw;
-      spin = joystick_gains_list_[BalanceControl::BAL_LO][1] * joystick_spin;
-      BalanceControl::UpdateReference(forw, spin);
-
-      // Calculate state Error
-      error_ = state_ - ref_state_;
-
-      // Gains
-      pd_gains_ = pd_gains_list_[BalanceControl::BAL_LO];
-      if (dynamic_lqr_ == true) {
-        Eigen::MatrixXd LQR_Gains;
-        LQR_Gains = BalanceControl::ComputeLqrGains();
-        pd_gains_.head(4) = -LQR_Gains;
-      }
+//============================================================================
+const BalanceControl::ModeControllerFn
+    BalanceControl::kModeControllers[NUM_MODES] = {
+        &BalanceControl::ModeController<BalanceControl::GROUND_LO>,
+        &BalanceControl::ModeController<BalanceControl::STAND>,
+        &BalanceControl::ModeController<BalanceControl::SIT>,
+        &BalanceControl::ModeController<BalanceControl::BAL_LO>,
+        &BalanceControl::ModeController<BalanceControl::BAL_HI>,
+        &BalanceControl::ModeController<BalanceControl::GROUND_HI>};
 
-      // Compute the current
-      BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
+//============================================================================
+void BalanceControl::BalancingController(double* control_input) {
+  (this->*kModeControllers[balance_mode_])(control_input);
+}
 
-      break;
-    }
-    case BalanceControl::BAL_HI: {
-      //  Update Reference
-      double forw, spin;
-      forw = joystick_gains_list_[BalanceControl::BAL_HI][0] * joystick_forw;
-      spin = joystick_gains_list_[BalanceControl::BAL_HI][1] * joystick_spin;
-      BalanceControl::UpdateReference(forw, spin);
-
-      // Calculate state Error
-      error_ = state_ - ref_state_;
-
-      // Gains
-      pd_gains_ = pd_gains_list_[BalanceControl::BAL_HI];
-      if (dynamic_lqr_ == true) {
-        Eigen::MatrixXd LQR_Gains;
-        LQR_Gains = BalanceControl::ComputeLqrGains();
-        pd_gains_.head(4) = -LQR_Gains;
-      }
+//============================================================================
+void BalanceControl::Print() {
+  ControlSnapshot snapshot;
+  Snapshot(&snapshot);
+  PrintControlSnapshot(snapshot);
+}
+
+//============================================================================
+void BalanceControl::Snapshot(ControlSnapshot* snapshot) const {
+  for (int i = 0; i < 6; i++) {
+    snapshot->state[i] = state_(i);
+    snapshot->ref_state[i] = ref_state_(i);
+    snapshot->error[i] = error_(i);
+    snapshot->pd_gains[i] = pd_gains_(i);
+  }
+  for (int i = 0; i < 3; i++) snapshot->com[i] = com_(i);
+  snapshot->joystick_forw = joystick_forw;
+  snapshot->joystick_spin = joystick_spin;
+  snapshot->control_input[0] = control_input_[0];
+  snapshot->control_input[1] = control_input_[1];
+  snapshot->imu = sensors_.imu;
+  snapshot->waist_angle = sensors_.waist_pos[0];
+  snapshot->dt = dt_;
+  snapshot->dt_filtered = dt_estimator_.filtered_dt();
+  snapshot->dt_jitter = dt_estimator_.jitter();
+  snapshot->lqr_gain_age = lqr_gain_age_;
+  snapshot->lqr_cache_hits =
+      (lqr_gain_cache_ != NULL ? lqr_gain_cache_->hits() : 0);
+  snapshot->lqr_cache_misses =
+      (lqr_gain_cache_ != NULL ? lqr_gain_cache_->misses() : 0);
+  snapshot->lqr_linearizations = num_linearizations_;
+  snapshot->lqr_reuses = num_linearization_reuses_;
+  snapshot->lqr_table_misses = num_table_misses_;
+  snapshot->balance_mode = balance_mode_;
+  snapshot->dynamic_lqr = (dynamic_lqr_ ? 1 : 0);
+}
 
-      // Compute the current
-      BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
+//============================================================================
+void BalanceControl::GetEventState(ControlEventState* event_state) const {
+  event_state->balance_mode = balance_mode_;
+  event_state->ref_forw = ref_state_(2);
+  event_state->ref_spin = ref_state_(4);
+  for (int i = 0; i < 6; i++)
+    event_state->pd_gains[i] = pd_gains_list_[balance_mode_](i);
+  event_state->joystick_forw = joystick_forw;
+  event_state->joystick_spin = joystick_spin;
+  event_state->stood_up_timer = stood_up_timer_;
+  for (int i = 0; i < 4; i++)
+    event_state->lqr_hack_ratios[i] = lqr_hack_ratios_(i, i);
+}
 
-      break;
-    }
-    case BalanceControl::SIT: {
-      //  Update Reference
-      double forw, spin;
-      forw = 0.0;
-      spin = 0.0;
-      BalanceControl::UpdateReference(forw, spin);
-
-      // Calculate state Error
-      const double kImuSitAngle = ((imu_sit_angle_ / 180.0) * M_PI);
-      error_ = state_ - ref_state_;
-      error_(0) = krang_->imu - kImuSitAngle;
-
-      // Gains - turn off fwd and spin control i.e. only control theta
-      pd_gains_.head(2) = pd_gains_list_[BalanceControl::SIT].head(2);
-
-      // Compute the current
-      BalanceControl::ComputeCurrent(pd_gains_, error_, &control_input[0]);
-
-      // State Transitions - If sat down switch to Ground Lo Mode
-      if (krang_->imu < kImuSitAngle) {
-        std::cout << "imu (" << krang_->imu << ") < limit (" << kImuSitAngle
-                  << "):";
-        std::cout << "changing to Ground Lo Mode" << std::endl;
-        balance_mode_ = BalanceControl::GROUND_LO;
-      }
+//============================================================================
+void BalanceControl::SetEventState(const ControlEventState& event_state) {
+  balance_mode_ = (BalanceMode)event_state.balance_mode;
+  ref_state_(2) = event_state.ref_forw;
+  ref_state_(4) = event_state.ref_spin;
+  for (int i = 0; i < 6; i++)
+    pd_gains_list_[balance_mode_](i) = event_state.pd_gains[i];
+  joystick_forw = event_state.joystick_forw;
+  joystick_spin = event_state.joystick_spin;
+  stood_up_timer_ = event_state.stood_up_timer;
+  for (int i = 0; i < 4; i++)
+    lqr_hack_ratios_(i, i) = event_state.lqr_hack_ratios[i];
+}
+
+//============================================================================
+bool SameEventState(const ControlEventState& a, const ControlEventState& b) {
+  if (a.balance_mode != b.balance_mode || a.ref_forw != b.ref_forw ||
+      a.ref_spin != b.ref_spin || a.joystick_forw != b.joystick_forw ||
+      a.joystick_spin != b.joystick_spin ||
+      a.stood_up_timer != b.stood_up_timer)
+    return false;
+  for (int i = 0; i < 6; i++)
+    if (a.pd_gains[i] != b.pd_gains[i]) return false;
+  for (int i = 0; i < 4; i++)
+    if (a.lqr_hack_ratios[i] != b.lqr_hack_ratios[i]) return false;
+  return true;
+}
+
+//============================================================================
+void BalanceControl::SetTuning(const ControlTuning& tuning) {
+  for (int mode = 0; mode < NUM_MODES; mode++) {
+    for (int i = 0; i < 6; i++)
+      pd_gains_list_[mode](i) = tuning.pd_gains[mode][i];
+    for (int i = 0; i < 2; i++)
+      joystick_gains_list_[mode][i] = tuning.joystick_gains[mode][i];
+  }
+  to_bal_threshold_ = tuning.to_bal_threshold;
+  start_bal_threshold_lo_ = tuning.start_bal_threshold_lo;
+  start_bal_threshold_hi_ = tuning.start_bal_threshold_hi;
+  imu_sit_angle_ = tuning.imu_sit_angle;
+  waist_hi_lo_threshold_ = tuning.waist_hi_lo_threshold;
+  for (int i = 0; i < 4; i++)
+    lqr_hack_ratios_(i, i) = tuning.lqr_hack_ratios[i];
+
+  bool same_costs = (lqrR_(0, 0) == tuning.lqr_r);
+  for (int i = 0; i < 4; i++) same_costs &= (lqrQ_(i, i) == tuning.lqr_q[i]);
+  if (same_costs) return;
+
+  // None of the lqr gains solved so far are for the new costs
+  lqrQ_.setZero();
+  for (int i = 0; i < 4; i++) lqrQ_(i, i) = tuning.lqr_q[i];
+  lqrR_(0, 0) = tuning.lqr_r;
+  has_linearization_ = false;
+  if (lqr_gain_cache_ != NULL) lqr_gain_cache_->Clear();
+  if (lqr_worker_ != NULL) lqr_worker_->SetCosts(lqrQ_, lqrR_);
+  if (use_lqr_gain_table_ &&
+      !lqr_gain_table_.Matches(is_simulation_, lqrQ_, lqrR_,
+                               com_parameters_hash_)) {
+    std::cout << "[ERR ] Falling back to online lqr gains" << std::endl;
+    use_lqr_gain_table_ = false;
+  }
+}
 
-      break;
+//============================================================================
+void BalanceControl::GetTuning(ControlTuning* tuning) const {
+  for (int mode = 0; mode < NUM_MODES; mode++) {
+    for (int i = 0; i < 6; i++)
+      tuning->pd_gains[mode][i] = pd_gains_list_[mode](i);
+    for (int i = 0; i < 2; i++)
+      tuning->joystick_gains[mode][i] = joystick_gains_list_[mode][i];
+  }
+  for (int i = 0; i < 4; i++) tuning->lqr_q[i] = lqrQ_(i, i);
+  tuning->lqr_r = lqrR_(0, 0);
+  tuning->to_bal_threshold = to_bal_threshold_;
+  tuning->start_bal_threshold_lo = start_bal_threshold_lo_;
+  tuning->start_bal_threshold_hi = start_bal_threshold_hi_;
+  tuning->imu_sit_angle = imu_sit_angle_;
+  tuning->waist_hi_lo_threshold = waist_hi_lo_threshold_;
+  for (int i = 0; i < 4; i++)
+    tuning->lqr_hack_ratios[i] = lqr_hack_ratios_(i, i);
+}
+
+//============================================================================
+void GetControlTuning(const BalancingConfig& params, ControlTuning* tuning) {
+  const Eigen::Matrix<double, 6, 1>* pd_gains[BalanceControl::NUM_MODES];
+  const double* joystick_gains[BalanceControl::NUM_MODES];
+  pd_gains[BalanceControl::GROUND_LO] = &params.pdGainsGroundLo;
+  pd_gains[BalanceControl::GROUND_HI] = &params.pdGainsGroundHi;
+  pd_gains[BalanceControl::STAND] = &params.pdGainsStand;
+  pd_gains[BalanceControl::SIT] = &params.pdGainsSit;
+  pd_gains[BalanceControl::BAL_LO] = &params.pdGainsBalLo;
+  pd_gains[BalanceControl::BAL_HI] = &params.pdGainsBalHi;
+  joystick_gains[BalanceControl::GROUND_LO] = params.joystickGainsGroundLo;
+  joystick_gains[BalanceControl::GROUND_HI] = params.joystickGainsGroundHi;
+  joystick_gains[BalanceControl::STAND] = params.joystickGainsStand;
+  joystick_gains[BalanceControl::SIT] = params.joystickGainsSit;
+  joystick_gains[BalanceControl::BAL_LO] = params.joystickGainsBalLo;
+  joystick_gains[BalanceControl::BAL_HI] = params.joystickGainsBalHi;
+  for (int mode = 0; mode < BalanceControl::NUM_MODES; mode++) {
+    for (int i = 0; i < 6; i++)
+      tuning->pd_gains[mode][i] = (*pd_gains[mode])(i);
+    for (int i = 0; i < 2; i++)
+      tuning->joystick_gains[mode][i] = joystick_gains[mode][i];
+  }
+  for (int i = 0; i < 4; i++) tuning->lqr_q[i] = params.lqrQ(i, i);
+  tuning->lqr_r = params.lqrR(0, 0);
+  tuning->to_bal_threshold = params.toBalThreshold;
+  tuning->start_bal_threshold_lo = params.startBalThresholdLo;
+  tuning->start_bal_threshold_hi = params.startBalThresholdHi;
+  tuning->imu_sit_angle = params.imuSitAngle;
+  tuning->waist_hi_lo_threshold = params.waistHiLoThreshold;
+  for (int i = 0; i < 4; i++) tuning->lqr_hack_ratios[i] = 1.0;
+}
+
+//============================================================================
+bool ComputeLqrHackRatios(const Eigen::Matrix<double, 4, 4>& A,
+                          const Eigen::Matrix<double, 4, 1>& B,
+                          ControlTuning* tuning) {
+  Eigen::Matrix<double, 4, 4> Q = Eigen::Matrix<double, 4, 4>::Zero();
+  for (int i = 0; i < 4; i++) Q(i, i) = tuning->lqr_q[i];
+  Eigen::Matrix<double, 1, 1> R;
+  R(0, 0) = tuning->lqr_r;
+  Eigen::Matrix<double, 4, 1> lqrGains;
+  SolveLqrGains(A, B, Q, R, &lqrGains);
+  bool finite = true;
+  for (int i = 0; i < 4; i++) {
+    tuning->lqr_hack_ratios[i] =
+        tuning->pd_gains[BalanceControl::STAND][i] / -lqrGains(i);
+    finite &= std::isfinite(tuning->lqr_hack_ratios[i]);
+  }
+  return finite;
+}
+
+//============================================================================
+bool ValidateControlTuning(const ControlTuning& tuning) {
+  // Every member is a double
+  const double* values = (const double*)&tuning;
+  for (size_t i = 0; i < sizeof(tuning) / sizeof(double); i++) {
+    if (!std::isfinite(values[i])) {
+      std::cout << "[ERR ] Gains and thresholds must be finite numbers"
+                << std::endl;
+      return false;
+    }
+  }
+  bool any_q = false;
+  for (int i = 0; i < 4; i++) {
+    if (tuning.lqr_q[i] < 0.0) {
+      std::cout << "[ERR ] lqrQ must not be negative" << std::endl;
+      return false;
     }
+    any_q |= (tuning.lqr_q[i] > 0.0);
   }
+  if (!any_q || tuning.lqr_r <= 0.0) {
+    std::cout << "[ERR ] lqrQ must not be all zero and lqrR must be positive"
+              << std::endl;
+    return false;
+  }
+  if (tuning.start_bal_threshold_lo >= tuning.start_bal_threshold_hi) {
+    std::cout << "[ERR ] startBalThresholdLo must be below startBalThresholdHi"
+              << std::endl;
+    return false;
+  }
+  if (tuning.to_bal_threshold < 0.0) {
+    std::cout << "[ERR ] toBalThreshold must not be negative" << std::endl;
+    return false;
+  }
+  return true;
 }
 
 //============================================================================
-void BalanceControl::Print() {
-  std::cout << "\nstate: " << state_.transpose() << std::endl;
-  std::cout << "com: " << com_.transpose() << std::endl;
-  std::cout << "WAIST ANGLE: " << krang_->waist->pos[0] << std::endl;
-  std::cout << "js_forw: " << joystick_forw;
-  std::cout << ", js_spin: " << joystick_spin << std::endl;
-  std::cout << "refState: " << ref_state_.transpose() << std::endl;
-  std::cout << "error: " << error_.transpose();
-  std::cout << ", imu: " << krang_->imu / M_PI * 180.0 << std::endl;
-  std::cout << "dynamic lqr: " << (dynamic_lqr_? "true" : "false") << std::endl;
-  std::cout << "PD Gains: " << pd_gains_.transpose() << std::endl;
-  std::cout << "Mode : " << MODE_STRINGS[balance_mode_] << "      ";
-  std::cout << "dt: " << dt_ << std::endl;
+void PrintControlSnapshot(const ControlSnapshot& snapshot) {
+  typedef Eigen::Map<const Eigen::Matrix<double, 6, 1> > ConstVector6dMap;
+  typedef Eigen::Map<const Eigen::Matrix<double, 3, 1> > ConstVector3dMap;
+  std::cout << "\nstate: " << ConstVector6dMap(snapshot.state).transpose()
+            << std::endl;
+  std::cout << "com: " << ConstVector3dMap(snapshot.com).transpose()
+            << std::endl;
+  std::cout << "WAIST ANGLE: " << snapshot.waist_angle << std::endl;
+  std::cout << "js_forw: " << snapshot.joystick_forw;
+  std::cout << ", js_spin: " << snapshot.joystick_spin << std::endl;
+  std::cout << "refState: "
+            << ConstVector6dMap(snapshot.ref_state).transpose() << std::endl;
+  std::cout << "error: " << ConstVector6dMap(snapshot.error).transpose();
+  std::cout << ", imu: " << snapshot.imu / M_PI * 180.0 << std::endl;
+  std::cout << "dynamic lqr: " << (snapshot.dynamic_lqr ? "true" : "false");
+  std::cout << ", lqr gain age: " << snapshot.lqr_gain_age;
+  std::cout << ", lqr cache hits/misses: " << snapshot.lqr_cache_hits << "/"
+            << snapshot.lqr_cache_misses << std::endl;
+  std::cout << "lqr linearizations: " << snapshot.lqr_linearizations
+            << ", reused: " << snapshot.lqr_reuses
+            << ", arms off the gain table: " << snapshot.lqr_table_misses
+            << std::endl;
+  std::cout << "PD Gains: " << ConstVector6dMap(snapshot.pd_gains).transpose()
+            << std::endl;
+  std::cout << "Mode : " << BalanceControl::MODE_STRINGS[snapshot.balance_mode]
+            << "      ";
+  std::cout << "dt: " << snapshot.dt << ", filtered: " << snapshot.dt_filtered
+            << ", jitter: " << snapshot.dt_jitter << std::endl;
 }
 
 //============================================================================
@@ -536,7 +1055,7 @@ void BalanceControl::StandSitEvent() {
   // If in balLow mode and waist is not too high, sit down
   else if (balance_mode_ == BalanceControl::STAND ||
            balance_mode_ == BalanceControl::BAL_LO) {
-    if ((krang_->waist->pos[0] - krang_->waist->pos[1]) / 2.0 >
+    if ((sensors_.waist_pos[0] - sensors_.waist_pos[1]) / 2.0 >
         waist_hi_lo_threshold_ * M_PI / 180.0) {
       balance_mode_ = BalanceControl::SIT;
       std::cout << "[MODE] SIT " << std::endl;
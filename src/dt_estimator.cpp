@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file dt_estimator.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Derives the time step of the control loop from the timestamps of the
+ * sensor samples
+ */
+
+#include "balancing/dt_estimator.h"
+
+#include <cmath>     // fabs(), sqrt()
+#include <iostream>  // std::cout, std::endl
+
+/* ************************************************************************* */
+DtEstimator::DtEstimator(double initial_dt, double filter_gain, double max_dt)
+    : filter_gain_(filter_gain),
+      max_dt_(max_dt),
+      has_time_(false),
+      last_time_(0.0),
+      dt_(initial_dt),
+      filtered_dt_(initial_dt),
+      jitter_(0.0),
+      max_jitter_(0.0),
+      sum_squared_jitter_(0.0),
+      num_samples_(0),
+      num_steps_(0),
+      num_stale_(0),
+      num_clamped_(0) {}
+
+/* ************************************************************************* */
+double DtEstimator::Update(double time) {
+  num_samples_++;
+
+  // Without a previous timestamp, or if this one did not advance (the same
+  // sample read twice, or a clock that jumped back), the expected period is
+  // the best guess
+  double step = time - last_time_;
+  bool valid = has_time_ && step > 0.0;
+  if (has_time_ && !valid) num_stale_++;
+  has_time_ = true;
+  last_time_ = time;
+  if (!valid) {
+    dt_ = filtered_dt_;
+    jitter_ = 0.0;
+    return dt_;
+  }
+
+  if (step > max_dt_) {
+    step = max_dt_;
+    num_clamped_++;
+  }
+  jitter_ = step - filtered_dt_;
+  if (fabs(jitter_) > max_jitter_) max_jitter_ = fabs(jitter_);
+  sum_squared_jitter_ += jitter_ * jitter_;
+  num_steps_++;
+  filtered_dt_ += filter_gain_ * jitter_;
+  dt_ = step;
+  return dt_;
+}
+
+/* ************************************************************************* */
+double DtEstimator::jitter_rms() const {
+  return (num_steps_ > 0 ? sqrt(sum_squared_jitter_ / num_steps_) : 0.0);
+}
+
+/* ************************************************************************* */
+void DtEstimator::PrintStats() const {
+  std::cout << "[INFO] sensor time step: " << filtered_dt_ * 1e3
+            << " ms filtered, jitter rms " << jitter_rms() * 1e6
+            << " us, max " << max_jitter_ * 1e6 << " us over " << num_steps_
+            << " steps, " << num_stale_ << " stale and " << num_clamped_
+            << " clamped timestamps" << std::endl;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file fake_hardware_interface.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Implements the hardware interface in memory
+ */
+
+#include "balancing/fake_hardware_interface.h"
+
+#include <cstring>  // memset
+
+#include <somatic.pb-c.h>  // Somatic__WaistMode
+#include <dart/dart.hpp>   // dart::dynamics::SkeletonPtr
+
+#include "balancing/sensors.h"  // SensorSample
+
+//============================================================================
+FakeHardwareInterface::FakeHardwareInterface(dart::dynamics::SkeletonPtr robot)
+    : robot_(robot) {
+  memset(&sensors, 0, sizeof(sensors));
+  wheel_currents[0] = wheel_currents[1] = 0.0;
+  memset(arm_velocities, 0, sizeof(arm_velocities));
+  memset(arm_positions, 0, sizeof(arm_positions));
+  arm_halted[LEFT] = arm_halted[RIGHT] = true;
+  waist_mode = SOMATIC__WAIST_MODE__STOP;
+  torso_halted = true;
+  torso_velocity = 0.0;
+  num_commands = 0;
+}
+
+//============================================================================
+void FakeHardwareInterface::ReadSensors(double dt, SensorSample* sample) {
+  if (robot_ != NULL) {
+    for (int i = 0; i < sensors.num_dofs; i++)
+      robot_->setPosition(i, sensors.q[i]);
+  }
+  *sample = sensors;
+}
+
+//============================================================================
+void FakeHardwareInterface::SetWheelCurrents(const double* currents) {
+  wheel_currents[0] = currents[0];
+  wheel_currents[1] = currents[1];
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::HaltArm(Side side) {
+  arm_halted[side] = true;
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::ResetArm(Side side) {
+  arm_halted[side] = false;
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::SetArmVelocities(Side side, const double* dq) {
+  for (int i = 0; i < 7; i++) arm_velocities[side][i] = dq[i];
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::SetArmPositions(Side side, const double* q) {
+  for (int i = 0; i < 7; i++) arm_positions[side][i] = q[i];
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::SetWaistMode(Somatic__WaistMode mode) {
+  waist_mode = mode;
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::HaltTorso() {
+  torso_halted = true;
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::ResetTorso() {
+  torso_halted = false;
+  num_commands++;
+}
+
+//============================================================================
+void FakeHardwareInterface::SetTorsoVelocity(double dq) {
+  torso_velocity = dq;
+  num_commands++;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file flight_recorder.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Keeps the controller state of the latest iterations in a
+ * memory-mapped file
+ */
+
+#include "balancing/flight_recorder.h"
+
+#include <errno.h>     // errno
+#include <fcntl.h>     // open()
+#include <stdio.h>     // rename()
+#include <string.h>    // memset(), memcpy(), memcmp(), strerror()
+#include <sys/mman.h>  // mmap(), munmap()
+#include <sys/stat.h>  // fstat()
+#include <unistd.h>    // ftruncate(), close()
+
+#include <iostream>  // std::cout, std::endl
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+namespace {
+const char kFlightRecorderMagic[8] = "KRANGFR";
+}  // namespace
+
+//============================================================================
+FlightRecorder::FlightRecorder()
+    : header_(NULL), records_(NULL), mapping_size_(0) {}
+
+//============================================================================
+FlightRecorder::~FlightRecorder() { Close(); }
+
+//============================================================================
+bool FlightRecorder::Open(const char* path, uint64_t capacity) {
+  Close();
+  if (capacity == 0) return false;
+
+  // The recording of the previous run, e.g. the one that ended in a fall, is
+  // kept next to the new one rather than overwritten by a restart
+  std::string previous = std::string(path) + ".prev";
+  if (rename(path, previous.c_str()) != 0 && errno != ENOENT) {
+    std::cout << "[ERR ] Could not keep flight recording " << path << " as "
+              << previous << ": " << strerror(errno) << std::endl;
+  }
+
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cout << "[ERR ] Could not create flight recording " << path << ": "
+              << strerror(errno) << std::endl;
+    return false;
+  }
+  size_t size = sizeof(FlightRecorderHeader) + capacity * sizeof(FlightRecord);
+  if (ftruncate(fd, size) != 0) {
+    std::cout << "[ERR ] Could not resize flight recording " << path << ": "
+              << strerror(errno) << std::endl;
+    close(fd);
+    return false;
+  }
+  void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cout << "[ERR ] Could not map flight recording " << path << ": "
+              << strerror(errno) << std::endl;
+    return false;
+  }
+
+  // Touch every page now so that no page fault happens in the control loop
+  memset(mapping, 0, size);
+
+  header_ = (FlightRecorderHeader*)mapping;
+  records_ = (FlightRecord*)(header_ + 1);
+  mapping_size_ = size;
+  memcpy(header_->magic, kFlightRecorderMagic, sizeof(header_->magic));
+  header_->version = kFlightRecordVersion;
+  header_->record_size = sizeof(FlightRecord);
+  header_->capacity = capacity;
+  header_->num_records = 0;
+  std::cout << "Flight recorder: " << capacity << " records of "
+            << sizeof(FlightRecord) << " bytes in " << path << std::endl;
+  return true;
+}
+
+//============================================================================
+void FlightRecorder::Close() {
+  if (header_ == NULL) return;
+  munmap(header_, mapping_size_);
+  header_ = NULL;
+  records_ = NULL;
+  mapping_size_ = 0;
+}
+
+//============================================================================
+bool ReadFlightRecording(const char* path, std::vector<FlightRecord>* records) {
+  records->clear();
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    std::cout << "[ERR ] Could not open flight recording " << path << ": "
+              << strerror(errno) << std::endl;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      (size_t)st.st_size < sizeof(FlightRecorderHeader)) {
+    std::cout << "[ERR ] " << path << " is not a flight recording"
+              << std::endl;
+    close(fd);
+    return false;
+  }
+  void* mapping = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cout << "[ERR ] Could not map flight recording " << path << ": "
+              << strerror(errno) << std::endl;
+    return false;
+  }
+
+  // Check that the file was written with the same record layout
+  const FlightRecorderHeader* header = (const FlightRecorderHeader*)mapping;
+  bool valid =
+      (memcmp(header->magic, kFlightRecorderMagic, sizeof(header->magic)) ==
+           0 &&
+       header->version == kFlightRecordVersion &&
+       header->record_size == sizeof(FlightRecord) &&
+       sizeof(FlightRecorderHeader) + header->capacity * sizeof(FlightRecord) <=
+           (size_t)st.st_size);
+  if (!valid) {
+    std::cout << "[ERR ] " << path
+              << " is not a flight recording of version "
+              << kFlightRecordVersion << std::endl;
+    munmap(mapping, st.st_size);
+    return false;
+  }
+
+  // Unroll the ring, oldest record first
+  const FlightRecord* ring = (const FlightRecord*)(header + 1);
+  uint64_t num_records = __atomic_load_n(&header->num_records, __ATOMIC_ACQUIRE);
+  uint64_t count =
+      (num_records < header->capacity ? num_records : header->capacity);
+  records->reserve(count);
+  for (uint64_t i = num_records - count; i < num_records; i++)
+    records->push_back(ring[i % header->capacity]);
+
+  munmap(mapping, st.st_size);
+  return true;
+}
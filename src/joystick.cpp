@@ -43,9 +43,14 @@
 #include "balancing/joystick.h"
 
 #include <ach.h>
+#include <amino/time.h>  // aa_tm_future(), aa_tm_sec2timespec()
 #include <somatic.h>
+#include <somatic/util.h>  // somatic_sig_received
+#include <time.h>  // clock_gettime(), CLOCK_MONOTONIC
 #include <cmath>
 
+#include "balancing/logger.h"  // Logger
+
 /* ********************************************************************************************
  */
 // Order in which buttons of joystick appear on the data arrays from ach channel
@@ -93,6 +98,24 @@ bool Joystick::Update() {
   int r = 0;
   Somatic__Joystick* js_msg =
       SOMATIC_GET_LAST_UNPACK(r, somatic__joystick, NULL, 4096, &ach_chan);
+  return Decode(js_msg, r);
+}
+
+/* *****************************************************************************
+ */
+/// Same as Update() but blocks until a new message arrives or timeout seconds
+/// pass
+bool Joystick::WaitForUpdate(double timeout) {
+  int r = 0;
+  struct timespec abstime = aa_tm_future(aa_tm_sec2timespec(timeout));
+  Somatic__Joystick* js_msg = SOMATIC_WAIT_LAST_UNPACK(
+      r, somatic__joystick, NULL, 4096, &ach_chan, &abstime);
+  return Decode(js_msg, r);
+}
+
+/* *****************************************************************************
+ */
+bool Joystick::Decode(Somatic__Joystick* js_msg, int r) {
   if (!(ACH_OK == r || ACH_MISSED_FRAME == r) || (js_msg == NULL)) return false;
 
   // Get the values
@@ -387,3 +410,105 @@ void Joystick::MapToJoystickState(char* b, double* x) {
     last_bool_x[i] = bool_x[i];
   }
 }
+
+/* *****************************************************************************
+ */
+// Current CLOCK_MONOTONIC time in seconds
+static double MonotonicNow() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+/* *****************************************************************************
+ */
+JoystickState::JoystickState()
+    : fingerMode(Joystick::L1L2R1R2_FREE),
+      rightMode(Joystick::RIGHT_THUMB_FREE),
+      leftMode(Joystick::LEFT_THUMB_FREE),
+      receive_time(0.0) {
+  thumbValue[Joystick::LEFT] = 0.0;
+  thumbValue[Joystick::RIGHT] = 0.0;
+}
+
+/* *****************************************************************************
+ */
+/// Reads the joystick channel and publishes every decoded message so that the
+/// control loop never has to wait on ach
+void* JoystickThread(void* arg) {
+  JoystickShared* js_shared = (JoystickShared*)arg;
+  Joystick joystick;
+  JoystickState state;
+
+  while (!somatic_sig_received) {
+    // Wake up periodically to check whether the program is stopping
+    if (!joystick.WaitForUpdate(0.1)) continue;
+
+    state.fingerMode = joystick.fingerMode;
+    state.rightMode = joystick.rightMode;
+    state.leftMode = joystick.leftMode;
+    state.thumbValue[Joystick::LEFT] = joystick.thumbValue[Joystick::LEFT];
+    state.thumbValue[Joystick::RIGHT] = joystick.thumbValue[Joystick::RIGHT];
+    state.receive_time = MonotonicNow();
+    js_shared->state.Store(state);
+  }
+  return NULL;
+}
+
+/* *****************************************************************************
+ */
+/// Called by the control loop to get the latest joystick input in constant
+/// time
+bool ReadJoystickState(JoystickShared& js_shared, JoystickState* state,
+                       Logger* logger) {
+  // If the joystick thread happens to be publishing right now, keep using the
+  // previous input instead of waiting for it
+  JoystickState latest;
+  unsigned long version;
+  if (js_shared.state.TryLoad(&latest, &version) &&
+      version != js_shared.last_version) {
+    js_shared.last_version = version;
+    *state = latest;
+    if (js_shared.timed_out) {
+      js_shared.timed_out = false;
+      if (logger) logger->Message("[INFO] joystick: messages received again");
+    }
+    return true;
+  }
+
+  // The joystick has gone quiet, e.g. its daemon died or it is out of range.
+  // Let go of it rather than keep driving with the last input
+  if (js_shared.timeout > 0.0 && !js_shared.timed_out &&
+      state->receive_time > 0.0 &&
+      MonotonicNow() - state->receive_time > js_shared.timeout) {
+    js_shared.timed_out = true;
+    state->fingerMode = Joystick::L1L2R1R2_FREE;
+    state->rightMode = Joystick::RIGHT_THUMB_FREE;
+    state->leftMode = Joystick::LEFT_THUMB_FREE;
+    state->thumbValue[Joystick::LEFT] = 0.0;
+    state->thumbValue[Joystick::RIGHT] = 0.0;
+    if (logger) {
+      logger->Message(
+          "[ERR ] joystick: no message for %d ms, input set to free",
+          (int)(js_shared.timeout * 1e3));
+    }
+    return false;
+  }
+
+  // No new message. This is what MapToJoystickState() would decode if the
+  // same message were received again: the modes are listed in groups of
+  // press, hold, release, so presses become holds and releases become free
+  if (state->rightMode != Joystick::RIGHT_THUMB_FREE) {
+    if (state->rightMode % 3 == 0)
+      state->rightMode = (Joystick::RightThumb)(state->rightMode + 1);
+    else if (state->rightMode % 3 == 2)
+      state->rightMode = Joystick::RIGHT_THUMB_FREE;
+  }
+  if (state->leftMode != Joystick::LEFT_THUMB_FREE) {
+    if (state->leftMode % 3 == 0)
+      state->leftMode = (Joystick::LeftThumb)(state->leftMode + 1);
+    else if (state->leftMode % 3 == 2)
+      state->leftMode = Joystick::LEFT_THUMB_FREE;
+  }
+  return false;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file krang_hardware_interface.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Implements the hardware interface on top of Krang::Hardware and the
+ * somatic daemons
+ */
+
+#include "balancing/krang_hardware_interface.h"
+
+#include <ach.h>     // ach_open(), ach_close(), ACH_OK, ach_result_to_string()
+#include <stdio.h>   // fprintf()
+#include <string.h>  // memset()
+
+#include <amino/mem.h>        // aa_mem_region_release()
+#include <somatic.h>          // SOMATIC_: PACK_SEND, GET_LAST_UNPACK
+#include <somatic.pb-c.h>     // SOMATIC__MOTOR_PARAM__*
+#include <somatic/daemon.h>   // somatic_d_: t, opts_t, init(), destroy()
+#include <somatic/motor.h>    // somatic_motor_: cmd(), halt(), reset(), init()
+#include <dart/dart.hpp>      // dart::dynamics::SkeletonPtr
+#include <kore.hpp>           // Krang::Hardware
+
+#include "balancing/sensors.h"  // SensorSample
+
+//============================================================================
+KrangHardwareInterface::KrangHardwareInterface(somatic_d_t* daemon_cx,
+                                               Krang::Hardware* krang)
+    : daemon_cx_(daemon_cx), krang_(krang), sensor_time_(0.0) {
+  // A handle of our own on the state channel of the wheels, to read the
+  // timestamps of the messages that Krang::Hardware reads the wheels from
+  int r = ach_open(&amc_state_chan_, "amc-state", NULL);
+  aa_hard_assert(r == ACH_OK,
+                 "Ach failure '%s' on opening AMC channel (%s, line %d)\n",
+                 ach_result_to_string(static_cast<ach_status_t>(r)), __FILE__,
+                 __LINE__);
+
+  // The upper body thread sends its commands through a daemon context and
+  // motor handles of its own. Krang::Hardware keeps reading the state of the
+  // same motors on the balancing thread
+  somatic_d_opts_t opts;
+  memset(&opts, 0, sizeof(opts));
+  opts.ident = "01-balance-upper-body";
+  memset(&upper_body_cx_, 0, sizeof(upper_body_cx_));
+  somatic_d_init(&upper_body_cx_, &opts);
+  memset(arms_, 0, sizeof(arms_));
+  memset(&torso_, 0, sizeof(torso_));
+  somatic_motor_init(&upper_body_cx_, &arms_[LEFT], 7, "llwa-cmd",
+                     "llwa-state");
+  somatic_motor_init(&upper_body_cx_, &arms_[RIGHT], 7, "rlwa-cmd",
+                     "rlwa-state");
+  somatic_motor_init(&upper_body_cx_, &torso_, 1, "torso-cmd", "torso-state");
+  waist_cmd_ = somatic_waist_cmd_alloc();
+}
+
+//============================================================================
+KrangHardwareInterface::~KrangHardwareInterface() {
+  somatic_waist_cmd_free(waist_cmd_);
+  somatic_motor_destroy(&upper_body_cx_, &torso_);
+  somatic_motor_destroy(&upper_body_cx_, &arms_[RIGHT]);
+  somatic_motor_destroy(&upper_body_cx_, &arms_[LEFT]);
+  somatic_d_destroy(&upper_body_cx_);
+  ach_close(&amc_state_chan_);
+}
+
+//============================================================================
+void KrangHardwareInterface::ReadSensors(double dt, SensorSample* sample) {
+  // Read motor encoders, imu and ft and update dart skeleton
+  krang_->updateSensors(dt);
+
+  // The sample is stamped with the time the AMC daemon took the wheel
+  // readings. If no new message came since the previous iteration, or it has
+  // no time, the previous time is kept and DtEstimator counts it as stale.
+  // The message is decoded into the memory region of the daemon context, as
+  // Krang::Hardware does, rather than the heap
+  int r = 0;
+  Somatic__MotorState* amc_state = SOMATIC_GET_LAST_UNPACK(
+      r, somatic__motor_state, &daemon_cx_->pballoc, 4096, &amc_state_chan_);
+  if ((ACH_OK == r || ACH_MISSED_FRAME == r) && amc_state != NULL &&
+      amc_state->meta != NULL && amc_state->meta->time != NULL) {
+    sensor_time_ =
+        amc_state->meta->time->sec + 1e-9 * amc_state->meta->time->nsec;
+  }
+  aa_mem_region_release(&daemon_cx_->memreg);
+  sample->time = sensor_time_;
+
+  sample->imu = krang_->imu;
+  sample->imu_speed = krang_->imuSpeed;
+  for (int i = 0; i < 2; i++) {
+    sample->amc_pos[i] = krang_->amc->pos[i];
+    sample->amc_vel[i] = krang_->amc->vel[i];
+    sample->waist_pos[i] = krang_->waist->pos[i];
+  }
+  sample->num_dofs = krang_->robot->getNumDofs();
+  for (int i = 0; i < sample->num_dofs; i++)
+    sample->q[i] = krang_->robot->getPosition(i);
+}
+
+//============================================================================
+void KrangHardwareInterface::SetWheelCurrents(const double* currents) {
+  double input[] = {currents[0], currents[1]};
+  somatic_motor_cmd(daemon_cx_, krang_->amc,
+                    SOMATIC__MOTOR_PARAM__MOTOR_CURRENT, input, 2, NULL);
+}
+
+//============================================================================
+void KrangHardwareInterface::HaltArm(Side side) {
+  somatic_motor_halt(&upper_body_cx_, &arms_[side]);
+}
+
+//============================================================================
+void KrangHardwareInterface::ResetArm(Side side) {
+  somatic_motor_reset(&upper_body_cx_, &arms_[side]);
+}
+
+//============================================================================
+void KrangHardwareInterface::SetArmVelocities(Side side, const double* dq) {
+  double input[7];
+  for (int i = 0; i < 7; i++) input[i] = dq[i];
+  somatic_motor_cmd(&upper_body_cx_, &arms_[side],
+                    SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, input, 7, NULL);
+}
+
+//============================================================================
+void KrangHardwareInterface::SetArmPositions(Side side, const double* q) {
+  double input[7];
+  for (int i = 0; i < 7; i++) input[i] = q[i];
+  somatic_motor_cmd(&upper_body_cx_, &arms_[side],
+                    SOMATIC__MOTOR_PARAM__MOTOR_POSITION, input, 7, NULL);
+}
+
+//============================================================================
+void KrangHardwareInterface::SetWaistMode(Somatic__WaistMode mode) {
+  // Send message to the krang-waist daemon
+  somatic_waist_cmd_set(waist_cmd_, mode);
+  int r =
+      SOMATIC_PACK_SEND(krang_->waistCmdChan, somatic__waist_cmd, waist_cmd_);
+  if (ACH_OK != r)
+    fprintf(stderr, "Couldn't send message: %s\n",
+            ach_result_to_string(static_cast<ach_status_t>(r)));
+}
+
+//============================================================================
+void KrangHardwareInterface::HaltTorso() {
+  somatic_motor_halt(&upper_body_cx_, &torso_);
+}
+
+//============================================================================
+void KrangHardwareInterface::ResetTorso() {
+  somatic_motor_reset(&upper_body_cx_, &torso_);
+}
+
+//============================================================================
+void KrangHardwareInterface::SetTorsoVelocity(double dq) {
+  double input[] = {dq};
+  somatic_motor_cmd(&upper_body_cx_, &torso_,
+                    SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, input, 1, NULL);
+}
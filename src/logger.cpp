@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file logger.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Prints the state of the main loop from a separate thread
+ */
+
+#include "balancing/logger.h"
+
+#include <pthread.h>         // pthread_create(), pthread_join()
+#include <stdarg.h>          // va_list, va_start(), va_end()
+#include <stdio.h>           // vsnprintf()
+#include <sys/resource.h>    // setpriority()
+#include <sys/syscall.h>     // SYS_gettid
+#include <unistd.h>          // usleep(), syscall()
+
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/control.h"        // PrintControlSnapshot()
+#include "balancing/tick_profiler.h"  // TickProfiler
+
+/* ************************************************************************* */
+void PrintLogRecord(const LogRecord& record) {
+  std::cout << "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv\n" << std::endl;
+  std::cout << "Interface: "
+            << (record.is_simulation ? "simulation" : "hardware");
+  PrintControlSnapshot(record.control);
+  std::cout << "time: " << record.time << std::endl;
+  if (record.loop_timer_enabled) {
+    std::cout << "overruns: " << record.num_overruns
+              << ", missed deadlines: " << record.num_missed_deadlines
+              << std::endl;
+  }
+  if (record.started) std::cout << "Started..." << std::endl;
+}
+
+/* ************************************************************************* */
+// Messages are rare (warnings and state changes), so a few slots are enough
+const size_t kNumLogMessages = 64;
+
+/* ************************************************************************* */
+Logger::Logger(size_t capacity)
+    : ring_(capacity),
+      messages_(kNumLogMessages),
+      num_dropped_(0),
+      num_dropped_messages_(0),
+      profile_(new TickProfiler(NULL, 0)),
+      profile_pending_(false),
+      running_(false) {}
+
+/* ************************************************************************* */
+Logger::~Logger() {
+  Stop();
+  delete profile_;
+}
+
+/* ************************************************************************* */
+void Logger::Start() {
+  if (running_.load()) return;
+  running_.store(true);
+  pthread_create(&thread_, NULL, &Logger::Run, this);
+}
+
+/* ************************************************************************* */
+void Logger::Stop() {
+  if (!running_.load()) return;
+  running_.store(false);
+  pthread_join(thread_, NULL);
+}
+
+/* ************************************************************************* */
+bool Logger::Log(const LogRecord& record) {
+  if (ring_.TryPush(record)) return true;
+  num_dropped_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+/* ************************************************************************* */
+bool Logger::Message(const char* format, ...) {
+  LogMessage message;
+  va_list args;
+  va_start(args, format);
+  vsnprintf(message.text, sizeof(message.text), format, args);
+  va_end(args);
+  if (messages_.TryPush(message)) return true;
+  num_dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+/* ************************************************************************* */
+bool Logger::DumpProfile(const TickProfiler& profiler) {
+  if (profile_pending_.load(std::memory_order_acquire)) return false;
+  *profile_ = profiler;
+  profile_pending_.store(true, std::memory_order_release);
+  return true;
+}
+
+/* ************************************************************************* */
+void* Logger::Run(void* arg) {
+  Logger* logger = (Logger*)arg;
+
+  // Printing should never compete with the control thread for the cpu
+  setpriority(PRIO_PROCESS, syscall(SYS_gettid), 10);
+
+  LogRecord record;
+  LogMessage message;
+  unsigned long num_dropped_reported = 0;
+  unsigned long num_dropped_messages_reported = 0;
+  while (true) {
+    // Read the flag before draining so that records logged before Stop() are
+    // still printed
+    bool running = logger->running_.load();
+    while (logger->messages_.TryPop(&message))
+      std::cout << message.text << std::endl;
+    while (logger->ring_.TryPop(&record)) PrintLogRecord(record);
+    if (logger->profile_pending_.load(std::memory_order_acquire)) {
+      logger->profile_->Print();
+      logger->profile_pending_.store(false, std::memory_order_release);
+    }
+
+    unsigned long num_dropped = logger->num_dropped();
+    if (num_dropped != num_dropped_reported) {
+      std::cout << "[WARN] logger dropped "
+                << num_dropped - num_dropped_reported << " records"
+                << std::endl;
+      num_dropped_reported = num_dropped;
+    }
+    unsigned long num_dropped_messages = logger->num_dropped_messages();
+    if (num_dropped_messages != num_dropped_messages_reported) {
+      std::cout << "[WARN] logger dropped "
+                << num_dropped_messages - num_dropped_messages_reported
+                << " messages" << std::endl;
+      num_dropped_messages_reported = num_dropped_messages;
+    }
+
+    if (!running) break;
+    usleep(10000);
+  }
+  return NULL;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file loop_timer.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Runs the control loop at a fixed rate
+ */
+
+#include "balancing/loop_timer.h"
+
+#include <errno.h>  // EINTR
+#include <time.h>   // clock_gettime(), clock_nanosleep()
+
+#include <iostream>  // std::cout, std::endl
+
+namespace {
+const long kNanosecondsPerSecond = 1000000000L;
+
+// Difference a - b in nanoseconds
+long DiffNanoseconds(const struct timespec& a, const struct timespec& b) {
+  return (a.tv_sec - b.tv_sec) * kNanosecondsPerSecond +
+         (a.tv_nsec - b.tv_nsec);
+}
+
+// Advances t by the given number of nanoseconds
+void AddNanoseconds(struct timespec* t, long ns) {
+  t->tv_sec += ns / kNanosecondsPerSecond;
+  t->tv_nsec += ns % kNanosecondsPerSecond;
+  if (t->tv_nsec >= kNanosecondsPerSecond) {
+    t->tv_sec++;
+    t->tv_nsec -= kNanosecondsPerSecond;
+  }
+}
+}  // namespace
+
+//============================================================================
+LoopTimer::LoopTimer(double rate)
+    : period_ns_(rate > 0.0 ? (long)(1e9 / rate) : 0),
+      num_ticks_(0),
+      num_overruns_(0),
+      num_missed_deadlines_(0),
+      max_lateness_ns_(0) {
+  deadline_.tv_sec = 0;
+  deadline_.tv_nsec = 0;
+}
+
+//============================================================================
+void LoopTimer::Start() {
+  clock_gettime(CLOCK_MONOTONIC, &deadline_);
+  AddNanoseconds(&deadline_, period_ns_);
+}
+
+//============================================================================
+int LoopTimer::Wait() {
+  if (!enabled()) return 1;
+  num_ticks_++;
+
+  // If the loop body overran the deadline, skip the periods that were missed
+  // so that the next deadline lies in the future again
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  long lateness = DiffNanoseconds(now, deadline_);
+  int periods = 1;
+  if (lateness > 0) {
+    int missed = (int)(lateness / period_ns_) + 1;
+    num_overruns_++;
+    num_missed_deadlines_ += missed;
+    if (lateness > max_lateness_ns_) max_lateness_ns_ = lateness;
+    AddNanoseconds(&deadline_, missed * period_ns_);
+    periods += missed;
+  }
+
+  // Sleep until the absolute deadline. Restart the sleep if it is interrupted
+  // by a signal
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline_, NULL) ==
+         EINTR) {
+  }
+  AddNanoseconds(&deadline_, period_ns_);
+  return periods;
+}
+
+//============================================================================
+void LoopTimer::PrintStats() const {
+  if (!enabled()) return;
+  std::cout << "loop rate: " << 1.0 / period() << " Hz, ticks: " << num_ticks_;
+  std::cout << ", overruns: " << num_overruns_;
+  std::cout << ", missed deadlines: " << num_missed_deadlines_;
+  std::cout << ", max lateness: " << max_lateness() * 1e3 << " ms"
+            << std::endl;
+}
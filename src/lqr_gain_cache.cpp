@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file lqr_gain_cache.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Keeps the LQR gains of recently seen upper body poses
+ */
+
+#include "balancing/lqr_gain_cache.h"
+
+#include <assert.h>  // assert()
+#include <math.h>    // floor()
+
+#include <Eigen/Eigen>  // Eigen::Matrix<double, #, #>
+
+/* ************************************************************************* */
+LqrGainCache::LqrGainCache(int capacity, double quantum)
+    : quantum_(quantum),
+      size_(0),
+      newest_(-1),
+      oldest_(-1),
+      hits_(0),
+      misses_(0) {
+  assert(capacity > 0 && quantum > 0.0);
+  entries_.resize(capacity);
+
+  // At least two buckets per entry keeps the chains short
+  int num_buckets = 1;
+  while (num_buckets < 2 * capacity) num_buckets *= 2;
+  buckets_.assign(num_buckets, -1);
+}
+
+/* ************************************************************************* */
+void LqrGainCache::MakeKey(const double* pose, Key* key) const {
+  for (int i = 0; i < kPoseSize; i++)
+    key->q[i] = (int32_t)floor(pose[i] / quantum_ + 0.5);
+}
+
+/* ************************************************************************* */
+uint64_t LqrGainCache::Hash(const Key& key) {
+  // FNV-1a over the bytes of the key
+  const unsigned char* bytes = (const unsigned char*)key.q;
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < sizeof(key.q); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/* ************************************************************************* */
+bool LqrGainCache::Equal(const Key& a, const Key& b) {
+  for (int i = 0; i < kPoseSize; i++) {
+    if (a.q[i] != b.q[i]) return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+bool LqrGainCache::Lookup(const Key& key, Eigen::Matrix<double, 4, 1>* gains) {
+  for (int index = buckets_[Bucket(key)]; index >= 0;
+       index = entries_[index].next_in_bucket) {
+    if (Equal(entries_[index].key, key)) {
+      for (int i = 0; i < 4; i++) (*gains)(i) = entries_[index].gains[i];
+      if (index != newest_) {
+        Unlink(index);
+        PushNewest(index);
+      }
+      hits_++;
+      return true;
+    }
+  }
+  misses_++;
+  return false;
+}
+
+/* ************************************************************************* */
+void LqrGainCache::Insert(const Key& key,
+                          const Eigen::Matrix<double, 4, 1>& gains) {
+  // A free entry, or the least recently used one
+  int index;
+  if (size_ < capacity()) {
+    index = size_++;
+  } else {
+    index = oldest_;
+    Unlink(index);
+    RemoveFromBucket(index);
+  }
+
+  Entry& entry = entries_[index];
+  entry.key = key;
+  for (int i = 0; i < 4; i++) entry.gains[i] = gains(i);
+  int bucket = Bucket(key);
+  entry.next_in_bucket = buckets_[bucket];
+  buckets_[bucket] = index;
+  PushNewest(index);
+}
+
+/* ************************************************************************* */
+void LqrGainCache::Clear() {
+  for (size_t i = 0; i < buckets_.size(); i++) buckets_[i] = -1;
+  size_ = 0;
+  newest_ = oldest_ = -1;
+}
+
+/* ************************************************************************* */
+void LqrGainCache::Unlink(int index) {
+  Entry& entry = entries_[index];
+  if (entry.newer >= 0)
+    entries_[entry.newer].older = entry.older;
+  else
+    newest_ = entry.older;
+  if (entry.older >= 0)
+    entries_[entry.older].newer = entry.newer;
+  else
+    oldest_ = entry.newer;
+}
+
+/* ************************************************************************* */
+void LqrGainCache::PushNewest(int index) {
+  Entry& entry = entries_[index];
+  entry.newer = -1;
+  entry.older = newest_;
+  if (newest_ >= 0) entries_[newest_].newer = index;
+  newest_ = index;
+  if (oldest_ < 0) oldest_ = index;
+}
+
+/* ************************************************************************* */
+void LqrGainCache::RemoveFromBucket(int index) {
+  int* link = &buckets_[Bucket(entries_[index].key)];
+  while (*link != index) link = &entries_[*link].next_in_bucket;
+  *link = entries_[index].next_in_bucket;
+}
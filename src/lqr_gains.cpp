@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file lqr_gains.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Computes the pose-dependent LQR gains of the balancing controller,
+ * online or from a precomputed table
+ */
+
+#include "balancing/lqr_gains.h"
+
+#include <stdio.h>   // FILE, fopen(), fread(), fwrite(), fclose()
+#include <string.h>  // memcmp(), memcpy()
+
+#include <algorithm>  // std::max(), std::min()
+#include <cmath>      // fabs()
+#include <iostream>   // std::cout, std::endl
+
+#include <Eigen/Eigen>    // Eigen::MatrixXd, Eigen::VectorXd
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr
+#include <krang-utils/linearize_wip.hpp>  // linearize_wip::ComputeLinearizedDynamics()
+#include <krang-utils/lqr.hpp>            // lqr()
+
+#include "balancing/riccati.h"  // RiccatiSolver
+
+static const char kLqrGainTableMagic[8] = "KRANGLQ";
+
+//============================================================================
+linearize_wip::ParametersNotFoundInUrdf WipMotorParameters(bool is_simulation) {
+  linearize_wip::ParametersNotFoundInUrdf params;
+  if (is_simulation) {
+    params.rotor_inertia = 0.0;
+    params.gear_ratio = 1;
+    params.wheel_radius = 0.25;
+  } else {
+    const double kKilogramMeterSquaredPerOunceInchSecondSquared = 0.00706154;
+    params.rotor_inertia =
+        0.022656 * kKilogramMeterSquaredPerOunceInchSecondSquared;
+    params.gear_ratio = 15;
+    params.wheel_radius = 0.25;
+  }
+  return params;
+}
+
+//============================================================================
+void LinearizeWip(dart::dynamics::SkeletonPtr robot, bool is_simulation,
+                  Eigen::MatrixXd* A, Eigen::MatrixXd* B) {
+  linearize_wip::ComputeLinearizedDynamics(
+      robot, WipMotorParameters(is_simulation), *A, *B);
+}
+
+//============================================================================
+void LinearizeWip(const WipParameters& wip, Eigen::Matrix<double, 4, 4>* A,
+                  Eigen::Matrix<double, 4, 1>* B) {
+  const double g = 9.81;
+  const double r = wip.motor.wheel_radius;
+
+  // The rotors turn with the wheels relative to the body, geared up
+  const double rotor =
+      wip.motor.rotor_inertia * wip.motor.gear_ratio * wip.motor.gear_ratio;
+
+  // Mass matrix of theta and x at the upright pose, and the gravity torque
+  // per unit theta
+  double m_tt = wip.body_inertia + rotor;
+  double m_tx = wip.body_mass * r * wip.com_distance - rotor;
+  double m_xx = (wip.body_mass + wip.wheel_mass) * r * r +
+                wip.wheel_inertia + rotor;
+  double det = m_tt * m_xx - m_tx * m_tx;
+  double gravity = wip.body_mass * g * wip.com_distance;
+
+  // M * [ddtheta; ddx] = [gravity * theta - torque; torque]
+  A->setZero();
+  (*A)(0, 1) = 1.0;
+  (*A)(1, 0) = m_xx * gravity / det;
+  (*A)(2, 3) = 1.0;
+  (*A)(3, 0) = -m_tx * gravity / det;
+  B->setZero();
+  (*B)(1) = -(m_xx + m_tx) / det;
+  (*B)(3) = (m_tt + m_tx) / det;
+}
+
+//============================================================================
+void ComputeLqrGains(dart::dynamics::SkeletonPtr robot, bool is_simulation,
+                     const Eigen::Matrix<double, 4, 4>& Q,
+                     const Eigen::Matrix<double, 1, 1>& R,
+                     Eigen::Matrix<double, 4, 1>* gains,
+                     RiccatiSolver<4, 1>* solver) {
+  // linearize_wip only takes dynamic-size matrices and allocates internally
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(4, 4);
+  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(4, 1);
+
+  // Find linearized model of the WIP
+  LinearizeWip(robot, is_simulation, &A, &B);
+
+  // Apply lqr on the linearized model
+  SolveLqrGains(Eigen::Matrix<double, 4, 4>(A), Eigen::Matrix<double, 4, 1>(B),
+                Q, R, gains, solver);
+}
+
+//============================================================================
+void SolveLqrGains(const Eigen::Matrix<double, 4, 4>& A,
+                   const Eigen::Matrix<double, 4, 1>& B,
+                   const Eigen::Matrix<double, 4, 4>& Q,
+                   const Eigen::Matrix<double, 1, 1>& R,
+                   Eigen::Matrix<double, 4, 1>* gains,
+                   RiccatiSolver<4, 1>* solver) {
+  Eigen::Matrix<double, 4, 1> LQR_Gains;
+  Eigen::Matrix<double, 1, 4> K;
+  if (solver != NULL && solver->Solve(A, B, Q, R, &K)) {
+    LQR_Gains = K.transpose();
+  } else {
+    // lqr() of krang-utils only takes dynamic-size matrices
+    Eigen::MatrixXd A_dynamic = A;
+    Eigen::MatrixXd B_dynamic = B;
+    Eigen::VectorXd lqr_gains = Eigen::VectorXd::Zero(4);
+    lqr(A_dynamic, B_dynamic, Q, R, lqr_gains);
+    LQR_Gains = lqr_gains;
+  }
+
+  const double motor_constant = 12.0 * 0.00706155183333;
+  const double gear_ratio = 15;
+  LQR_Gains /= (gear_ratio * motor_constant);
+
+  // LQR gains are calculated using a model that has one wheel. The torque
+  // needs to be distributed to either wheel, so needs to be halved
+  *gains = 0.5 * LQR_Gains;
+}
+
+//============================================================================
+uint64_t HashComParameters(const Eigen::MatrixXd& beta) {
+  // FNV-1a of the dimensions and the bytes of the values
+  uint64_t dims[2] = {(uint64_t)beta.rows(), (uint64_t)beta.cols()};
+  uint64_t hash = 14695981039346656037ULL;
+  const unsigned char* bytes = (const unsigned char*)dims;
+  for (size_t i = 0; i < sizeof(dims); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  bytes = (const unsigned char*)beta.data();
+  for (size_t i = 0; i < beta.size() * sizeof(double); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+//============================================================================
+LqrGainTable::LqrGainTable() { memset(&header_, 0, sizeof(header_)); }
+
+//============================================================================
+void LqrGainTable::Create(const LqrGainTableHeader& header) {
+  header_ = header;
+  memcpy(header_.magic, kLqrGainTableMagic, sizeof(header_.magic));
+  header_.version = kLqrGainTableVersion;
+  gains_.assign(4 * header_.num_waist * header_.num_torso, 0.0);
+}
+
+//============================================================================
+bool LqrGainTable::Load(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    std::cout << "[ERR ] Could not open lqr gain table " << path << std::endl;
+    return false;
+  }
+  LqrGainTableHeader header;
+  bool valid = (fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(header.magic, kLqrGainTableMagic,
+                       sizeof(header.magic)) == 0 &&
+                header.version == kLqrGainTableVersion &&
+                header.num_waist >= 2 && header.num_torso >= 2);
+  if (valid) {
+    header_ = header;
+    gains_.resize(4 * header_.num_waist * header_.num_torso);
+    valid = (fread(&gains_[0], sizeof(double), gains_.size(), file) ==
+             gains_.size());
+  }
+  fclose(file);
+  if (!valid) {
+    std::cout << "[ERR ] " << path << " is not a valid lqr gain table"
+              << std::endl;
+    gains_.clear();
+  }
+  return valid;
+}
+
+//============================================================================
+bool LqrGainTable::Save(const char* path) const {
+  FILE* file = fopen(path, "wb");
+  if (file == NULL) {
+    std::cout << "[ERR ] Could not create " << path << std::endl;
+    return false;
+  }
+  bool success =
+      (fwrite(&header_, sizeof(header_), 1, file) == 1 &&
+       fwrite(&gains_[0], sizeof(double), gains_.size(), file) ==
+           gains_.size());
+  success = (fclose(file) == 0) && success;
+  return success;
+}
+
+//============================================================================
+bool LqrGainTable::Matches(bool is_simulation,
+                           const Eigen::Matrix<double, 4, 4>& Q,
+                           const Eigen::Matrix<double, 1, 1>& R,
+                           uint64_t com_parameters_hash) const {
+  if ((header_.is_simulation != 0) != is_simulation) {
+    std::cout << "[ERR ] lqr gain table is for "
+              << (header_.is_simulation ? "simulation" : "hardware")
+              << std::endl;
+    return false;
+  }
+  bool same_costs = (header_.lqr_r == R(0, 0));
+  for (int i = 0; i < 4; i++) same_costs &= (header_.lqr_q[i] == Q(i, i));
+  if (!same_costs) {
+    std::cout << "[ERR ] lqr gain table was computed with other lqrQ/lqrR"
+              << std::endl;
+    return false;
+  }
+  if (header_.com_parameters_hash != com_parameters_hash) {
+    std::cout << "[ERR ] lqr gain table was computed with other CoM parameters"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//============================================================================
+bool LqrGainTable::ArmsAtPose(const double* arm_pose, double tolerance) const {
+  for (int i = 0; i < 14; i++)
+    if (fabs(arm_pose[i] - header_.arm_pose[i]) > tolerance) return false;
+  return true;
+}
+
+//============================================================================
+double LqrGainTable::waist(int i) const {
+  return header_.waist_min + (header_.waist_max - header_.waist_min) * i /
+                                 (header_.num_waist - 1);
+}
+
+//============================================================================
+double LqrGainTable::torso(int j) const {
+  return header_.torso_min + (header_.torso_max - header_.torso_min) * j /
+                                 (header_.num_torso - 1);
+}
+
+//============================================================================
+void LqrGainTable::Set(int i, int j, const Eigen::Matrix<double, 4, 1>& gains) {
+  for (int k = 0; k < 4; k++)
+    gains_[4 * (i * header_.num_torso + j) + k] = gains(k);
+}
+
+//============================================================================
+void LqrGainTable::Lookup(double waist, double torso,
+                          Eigen::Matrix<double, 4, 1>* gains) const {
+  // Continuous grid coordinates, clamped to the grid
+  double u = (waist - header_.waist_min) /
+             (header_.waist_max - header_.waist_min) * (header_.num_waist - 1);
+  double v = (torso - header_.torso_min) /
+             (header_.torso_max - header_.torso_min) * (header_.num_torso - 1);
+  u = std::max(0.0, std::min(u, header_.num_waist - 1.0));
+  v = std::max(0.0, std::min(v, header_.num_torso - 1.0));
+  int i = std::min((int)u, (int)header_.num_waist - 2);
+  int j = std::min((int)v, (int)header_.num_torso - 2);
+  double a = u - i, b = v - j;
+
+  const double* g00 = &gains_[4 * (i * header_.num_torso + j)];
+  const double* g01 = g00 + 4;
+  const double* g10 = g00 + 4 * header_.num_torso;
+  const double* g11 = g10 + 4;
+  for (int k = 0; k < 4; k++) {
+    (*gains)(k) = (1 - a) * ((1 - b) * g00[k] + b * g01[k]) +
+                  a * ((1 - b) * g10[k] + b * g11[k]);
+  }
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file lqr_worker.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Solves the dynamic LQR gains on a separate thread
+ */
+
+#include "balancing/lqr_worker.h"
+
+#include <pthread.h>       // pthread_create(), pthread_join()
+#include <sys/resource.h>  // setpriority()
+#include <sys/syscall.h>   // SYS_gettid
+#include <unistd.h>        // usleep(), syscall()
+
+#include <amino/time.h>   // aa_tm: _now(), _timespec2sec(), _sub()
+#include <Eigen/Eigen>    // Eigen::Matrix<double, #, #>
+#include <dart/dart.hpp>  // dart::dynamics::SkeletonPtr
+
+#include "balancing/lqr_gains.h"  // ComputeLqrGains()
+
+/* ************************************************************************* */
+LqrWorker::LqrWorker(dart::dynamics::SkeletonPtr robot, bool is_simulation,
+                     const Eigen::Matrix<double, 4, 4>& Q,
+                     const Eigen::Matrix<double, 1, 1>& R)
+    : robot_(robot->clone()),
+      is_simulation_(is_simulation),
+      Q_(Q),
+      R_(R),
+      costs_version_(0),
+      has_gains_(false),
+      running_(false) {}
+
+/* ************************************************************************* */
+LqrWorker::~LqrWorker() { Stop(); }
+
+/* ************************************************************************* */
+void LqrWorker::Start() {
+  if (running_.load()) return;
+  running_.store(true);
+  pthread_create(&thread_, NULL, &LqrWorker::Run, this);
+}
+
+/* ************************************************************************* */
+void LqrWorker::Stop() {
+  if (!running_.load()) return;
+  running_.store(false);
+  pthread_join(thread_, NULL);
+}
+
+/* ************************************************************************* */
+void LqrWorker::PublishPose(const double* q, int num_dofs) {
+  Pose pose;
+  pose.time = aa_tm_now();
+  pose.num_dofs = num_dofs;
+  for (int i = 0; i < num_dofs; i++) pose.q[i] = q[i];
+  for (int i = 0; i < 4; i++) pose.lqr_q[i] = Q_(i, i);
+  pose.lqr_r = R_(0, 0);
+  pose.costs_version = costs_version_;
+  pose_.Store(pose);
+}
+
+/* ************************************************************************* */
+void LqrWorker::SetCosts(const Eigen::Matrix<double, 4, 4>& Q,
+                         const Eigen::Matrix<double, 1, 1>& R) {
+  Q_ = Q;
+  R_ = R;
+  costs_version_++;
+  has_gains_ = false;
+}
+
+/* ************************************************************************* */
+bool LqrWorker::LatestGains(Eigen::Matrix<double, 4, 1>* gains,
+                            double* age) {
+  // If the solver is publishing right now, the previous gains are used
+  Gains newest;
+  unsigned long version;
+  if (gains_.TryLoad(&newest, &version) && version > 0 &&
+      newest.costs_version == costs_version_) {
+    latest_ = newest;
+    has_gains_ = true;
+  }
+  if (!has_gains_) return false;
+  for (int i = 0; i < 4; i++) (*gains)(i) = latest_.gains[i];
+  *age = aa_tm_timespec2sec(aa_tm_sub(aa_tm_now(), latest_.pose_time));
+  return true;
+}
+
+/* ************************************************************************* */
+void* LqrWorker::Run(void* arg) {
+  LqrWorker* worker = (LqrWorker*)arg;
+
+  // The control thread always comes first
+  setpriority(PRIO_PROCESS, syscall(SYS_gettid), 5);
+
+  unsigned long solved_version = 0;
+  Pose pose;
+  Gains result;
+  Eigen::Matrix<double, 4, 1> gains;
+  Eigen::Matrix<double, 4, 4> Q = Eigen::Matrix<double, 4, 4>::Zero();
+  Eigen::Matrix<double, 1, 1> R;
+  while (worker->running_.load()) {
+    // Solve only for poses that have not been solved yet
+    unsigned long version;
+    if (!worker->pose_.TryLoad(&pose, &version) || version == solved_version) {
+      usleep(200);
+      continue;
+    }
+    solved_version = version;
+
+    for (int i = 0; i < pose.num_dofs; i++)
+      worker->robot_->setPosition(i, pose.q[i]);
+    for (int i = 0; i < 4; i++) Q(i, i) = pose.lqr_q[i];
+    R(0, 0) = pose.lqr_r;
+    ComputeLqrGains(worker->robot_, worker->is_simulation_, Q, R, &gains,
+                    &worker->riccati_);
+    result.pose_time = pose.time;
+    for (int i = 0; i < 4; i++) result.gains[i] = gains(i);
+    result.costs_version = pose.costs_version;
+    worker->gains_.Store(result);
+  }
+  return NULL;
+}
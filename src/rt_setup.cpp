@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file rt_setup.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Prepares the process and the main loop for real-time execution
+ */
+
+#include "balancing/rt_setup.h"
+
+#include <alloca.h>    // alloca()
+#include <errno.h>     // errno
+#include <malloc.h>    // mallopt(), M_TRIM_THRESHOLD, M_MMAP_MAX
+#include <pthread.h>   // pthread_self(), pthread_set{affinity,schedparam}_np
+#include <sched.h>     // cpu_set_t, CPU_ZERO(), CPU_SET(), SCHED_FIFO
+#include <stdlib.h>    // malloc(), free(), strtol()
+#include <string.h>    // memset(), strerror()
+#include <sys/mman.h>  // mlockall(), MCL_CURRENT, MCL_FUTURE
+#include <unistd.h>    // sysconf(), _SC_PAGESIZE
+
+#include <iostream>  // std::cout, std::endl
+
+#include "balancing/balancing_config.h"  // BalancingConfig
+
+/* ************************************************************************* */
+// Parses a list of cpu numbers separated by spaces. Returns false if the list
+// is empty or has anything else in it
+static bool ParseCpus(const char* list, cpu_set_t* cpus) {
+  CPU_ZERO(cpus);
+  int num_cpus = 0;
+  const char* p = list;
+  while (*p != '\0') {
+    char* end;
+    long cpu = strtol(p, &end, 10);
+    if (end == p) {
+      if (*p != ' ') return false;
+      p++;
+      continue;
+    }
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    CPU_SET(cpu, cpus);
+    num_cpus++;
+    p = end;
+  }
+  return num_cpus > 0;
+}
+
+/* ************************************************************************* */
+// Pins the calling thread to the cpus in list, if any
+static bool SetAffinity(const char* list, const char* what) {
+  if (list[0] == '\0') return true;
+  cpu_set_t cpus;
+  if (!ParseCpus(list, &cpus)) {
+    std::cout << "[ERR ] rt: invalid cpu list \"" << list << "\" for " << what
+              << std::endl;
+    return false;
+  }
+  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (error != 0) {
+    std::cout << "[ERR ] rt: " << what << " on cpus " << list << ": "
+              << strerror(error) << std::endl;
+    return false;
+  }
+  std::cout << "[INFO] rt: " << what << " on cpus " << list << std::endl;
+  return true;
+}
+
+/* ************************************************************************* */
+// Writes to every page of size bytes of stack. Not inlined so that the array
+// is below the frame of the caller
+static void __attribute__((noinline)) PrefaultStack(size_t size) {
+  volatile char* stack = (volatile char*)alloca(size);
+  long page = sysconf(_SC_PAGESIZE);
+  for (size_t i = 0; i < size; i += page) stack[i] = 0;
+}
+
+/* ************************************************************************* */
+bool SetupRtProcess(const BalancingConfig& params) {
+  bool success = true;
+
+  if (params.rtLockMemory) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      std::cout << "[ERR ] rt: mlockall: " << strerror(errno) << std::endl;
+      success = false;
+    } else {
+      std::cout << "[INFO] rt: memory locked" << std::endl;
+    }
+  }
+
+  if (params.rtPrefaultHeapKb > 0) {
+    // Freed memory stays in the heap of malloc, and large blocks come from
+    // the heap too instead of a fresh mmap()
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    size_t size = (size_t)params.rtPrefaultHeapKb * 1024;
+    char* heap = (char*)malloc(size);
+    if (heap == NULL) {
+      std::cout << "[ERR ] rt: could not prefault " << params.rtPrefaultHeapKb
+                << " kB of heap" << std::endl;
+      success = false;
+    } else {
+      long page = sysconf(_SC_PAGESIZE);
+      for (size_t i = 0; i < size; i += page) heap[i] = 0;
+      free(heap);
+      std::cout << "[INFO] rt: prefaulted " << params.rtPrefaultHeapKb
+                << " kB of heap" << std::endl;
+    }
+  }
+
+  success = SetAffinity(params.rtAuxiliaryCpus, "auxiliary threads") &&
+            success;
+  return success;
+}
+
+/* ************************************************************************* */
+bool SetupRtControlThread(const BalancingConfig& params) {
+  bool success = SetAffinity(params.rtControlCpus, "main loop");
+
+  if (params.rtPriority > 0) {
+    struct sched_param sched;
+    memset(&sched, 0, sizeof(sched));
+    sched.sched_priority = params.rtPriority;
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sched);
+    if (error != 0) {
+      std::cout << "[ERR ] rt: SCHED_FIFO priority " << params.rtPriority
+                << ": " << strerror(error) << std::endl;
+      success = false;
+    } else {
+      std::cout << "[INFO] rt: main loop at SCHED_FIFO priority "
+                << params.rtPriority << std::endl;
+    }
+  }
+
+  if (params.rtPrefaultStackKb > 0) {
+    PrefaultStack((size_t)params.rtPrefaultStackKb * 1024);
+    std::cout << "[INFO] rt: prefaulted " << params.rtPrefaultStackKb
+              << " kB of stack" << std::endl;
+  }
+  return success;
+}
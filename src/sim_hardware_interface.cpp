@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file sim_hardware_interface.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Simulates the robot inside the balancing process
+ */
+
+#include "balancing/sim_hardware_interface.h"
+
+#include <algorithm>  // std::max(), std::min()
+#include <cmath>      // atan2, sin, cos, sqrt
+
+#include <somatic.pb-c.h>              // SOMATIC__WAIST_MODE__*
+#include <Eigen/Eigen>                 // Eigen::Vector3d, Eigen::Matrix3d
+#include <dart/dart.hpp>               // dart::dynamics
+#include <krang-sim-ach/dart_world.h>  // KrangInitPoseParams
+
+#include "balancing/sensors.h"  // SensorSample, k*Dof
+
+const double kWheelRadius = 0.25;  // (m)
+const double kGravity = 9.81;      // (m/s^2)
+
+// Wheel torque (Nm) per unit of commanded current: motor torque constant
+// times the gear ratios
+const double kTorquePerAmp = 15.0 * 12.0 * 0.00706155183333;
+
+// Speeds at which the waist moves when commanded and the arms move to a
+// commanded position (rad/s)
+const double kWaistSpeed = 0.1;
+const double kArmSpeed = 0.5;
+
+//============================================================================
+SimHardwareInterface::SimHardwareInterface(
+    dart::dynamics::SkeletonPtr robot, dart::dynamics::SkeletonPtr plant,
+    const krang_sim_ach::dart_world::KrangInitPoseParams& pose)
+    : robot_(robot), plant_(plant) {
+  lwheel_ = plant_->getBodyNode("LWheel");
+  rwheel_ = plant_->getBodyNode("RWheel");
+
+  // Initial pose, pitched about the wheel axle by q_base_init
+  Eigen::Isometry3d base_tf = Eigen::Isometry3d::Identity();
+  base_tf.linear() =
+      Eigen::AngleAxisd(pose.q_base_init, Eigen::Vector3d::UnitY())
+          .toRotationMatrix();
+  base_tf.translation() = pose.xyz_init;
+  Eigen::Vector6d base = dart::dynamics::FreeJoint::convertToPositions(base_tf);
+  for (int i = 0; i < 6; i++) plant_->setPosition(i, base(i));
+  plant_->setPosition(kLWheelDof, pose.q_lwheel_init);
+  plant_->setPosition(kRWheelDof, pose.q_rwheel_init);
+  plant_->setPosition(kWaistDof, pose.q_waist_init);
+  plant_->setPosition(kTorsoDof, pose.q_torso_init);
+  plant_->setPosition(kTorsoDof + 1, pose.q_kinect_init);
+  for (int i = 0; i < 7; i++) {
+    plant_->setPosition(kArmDof[LEFT] + i, pose.q_left_arm_init(i));
+    plant_->setPosition(kArmDof[RIGHT] + i, pose.q_right_arm_init(i));
+  }
+
+  // At rest on the ground
+  imu_ = pose.q_base_init;
+  imu_speed_ = 0.0;
+  wheel_ = (pose.q_lwheel_init + pose.q_rwheel_init) / 2.0 + imu_;
+  wheel_speed_ = 0.0;
+  spin_ = (pose.q_rwheel_init - pose.q_lwheel_init) / 2.0;
+  spin_speed_ = 0.0;
+  rest_imu_ = pose.q_base_init;
+  time_ = 0.0;
+
+  // Motors stopped
+  currents_[0] = currents_[1] = 0.0;
+  for (int side = 0; side < 2; side++) {
+    arm_mode_[side] = kHalted;
+    for (int i = 0; i < 7; i++) arm_command_[side][i] = 0.0;
+  }
+  waist_mode_ = SOMATIC__WAIST_MODE__STOP;
+  torso_halted_ = true;
+  torso_velocity_ = 0.0;
+}
+
+//============================================================================
+void SimHardwareInterface::Step(double dt) {
+  time_ += dt;
+  StepUpperBody(dt);
+
+  // Mass properties of the wheels and the body in the current pose. Axle is
+  // the unit vector from the left to the right wheel
+  Eigen::Vector3d axle_center = (lwheel_->getCOM() + rwheel_->getCOM()) / 2.0;
+  Eigen::Vector3d axle = rwheel_->getCOM() - lwheel_->getCOM();
+  double track = axle.norm();
+  axle /= track;
+  double wheel_mass = 0.0, wheel_inertia = 0.0, yaw_inertia = 0.0;
+  double body_mass = 0.0;
+  Eigen::Vector3d body_com = Eigen::Vector3d::Zero();
+  for (int i = 0; i < plant_->getNumBodyNodes(); i++) {
+    dart::dynamics::BodyNodePtr body = plant_->getBodyNode(i);
+    Eigen::Matrix3d rot = body->getWorldTransform().linear();
+    Eigen::Matrix3d inertia =
+        rot * body->getInertia().getMoment() * rot.transpose();
+    Eigen::Vector3d com = body->getCOM();
+    double mass = body->getMass();
+    yaw_inertia +=
+        inertia(2, 2) + mass * (com - axle_center).head(2).squaredNorm();
+    if (body == lwheel_ || body == rwheel_) {
+      wheel_mass += mass;
+      wheel_inertia += axle.dot(inertia * axle);
+    } else {
+      body_mass += mass;
+      body_com += mass * com;
+    }
+  }
+  body_com /= body_mass;
+  double pitch_inertia = 0.0;  // about the body com
+  for (int i = 0; i < plant_->getNumBodyNodes(); i++) {
+    dart::dynamics::BodyNodePtr body = plant_->getBodyNode(i);
+    if (body == lwheel_ || body == rwheel_) continue;
+    Eigen::Matrix3d rot = body->getWorldTransform().linear();
+    Eigen::Matrix3d inertia =
+        rot * body->getInertia().getMoment() * rot.transpose();
+    Eigen::Vector3d offset = body->getCOM() - body_com;
+    pitch_inertia += inertia(1, 1) + body->getMass() *
+                                         (offset(0) * offset(0) +
+                                          offset(2) * offset(2));
+  }
+  Eigen::Vector3d com = body_com - axle_center;
+  double theta = atan2(com(0), com(2));
+  double length = sqrt(com(0) * com(0) + com(2) * com(2));
+
+  // Wheel torques. The reaction acts on the body
+  double torque = kTorquePerAmp * (currents_[0] + currents_[1]);
+  double spin_torque = kTorquePerAmp * (currents_[1] - currents_[0]) / 2.0;
+
+  // Wheeled inverted pendulum
+  //   [a11 a12] [wheel_accel] = [b1]
+  //   [a12 a22] [pitch_accel]   [b2]
+  const double r = kWheelRadius;
+  double a11 = (wheel_mass + body_mass) * r * r + wheel_inertia;
+  double a12 = body_mass * r * length * cos(theta);
+  double a22 = body_mass * length * length + pitch_inertia;
+  double b1 = torque + body_mass * r * length * sin(theta) * imu_speed_ *
+                           imu_speed_;
+  double b2 = body_mass * kGravity * length * sin(theta) - torque;
+  double det = a11 * a22 - a12 * a12;
+  double wheel_accel = (a22 * b1 - a12 * b2) / det;
+  double pitch_accel = (a11 * b2 - a12 * b1) / det;
+
+  // On the ground the body does not pitch any further and the robot only
+  // rolls
+  bool resting =
+      (imu_ <= rest_imu_ && imu_speed_ <= 0.0 && pitch_accel <= 0.0);
+  if (resting) {
+    imu_speed_ = 0.0;
+    pitch_accel = 0.0;
+    wheel_accel = torque / a11;
+  }
+
+  // Spin: wheel inertia plus the yaw inertia seen through the wheels
+  double spin_accel =
+      spin_torque /
+      (wheel_inertia / 2.0 + 2.0 * r * r * yaw_inertia / (track * track));
+
+  // Semi-implicit Euler
+  imu_speed_ += pitch_accel * dt;
+  double pitch_change = imu_speed_ * dt;
+  if (imu_ + pitch_change < rest_imu_) {
+    pitch_change = rest_imu_ - imu_;
+    imu_speed_ = 0.0;
+  }
+  imu_ += pitch_change;
+  wheel_speed_ += wheel_accel * dt;
+  double wheel_change = wheel_speed_ * dt;
+  wheel_ += wheel_change;
+  spin_speed_ += spin_accel * dt;
+  spin_ += spin_speed_ * dt;
+
+  UpdatePlantPose(pitch_change, r * wheel_change);
+}
+
+//============================================================================
+void SimHardwareInterface::StepUpperBody(double dt) {
+  // Waist
+  double waist = plant_->getPosition(kWaistDof);
+  if (waist_mode_ == SOMATIC__WAIST_MODE__MOVE_FWD)
+    plant_->setPosition(kWaistDof, waist + kWaistSpeed * dt);
+  else if (waist_mode_ == SOMATIC__WAIST_MODE__MOVE_REV)
+    plant_->setPosition(kWaistDof, waist - kWaistSpeed * dt);
+
+  // Torso
+  if (!torso_halted_) {
+    plant_->setPosition(kTorsoDof,
+                        plant_->getPosition(kTorsoDof) + torso_velocity_ * dt);
+  }
+
+  // Arms
+  for (int side = 0; side < 2; side++) {
+    if (arm_mode_[side] == kHalted) continue;
+    for (int i = 0; i < 7; i++) {
+      int dof = kArmDof[side] + i;
+      double q = plant_->getPosition(dof);
+      if (arm_mode_[side] == kVelocity) {
+        q += arm_command_[side][i] * dt;
+      } else {
+        double step = arm_command_[side][i] - q;
+        q += std::max(-kArmSpeed * dt, std::min(kArmSpeed * dt, step));
+      }
+      plant_->setPosition(dof, q);
+    }
+  }
+}
+
+//============================================================================
+void SimHardwareInterface::UpdatePlantPose(double pitch_change,
+                                           double forward_change) {
+  // Pitch the base about the axle and move it forward
+  Eigen::Vector6d base;
+  for (int i = 0; i < 6; i++) base(i) = plant_->getPosition(i);
+  Eigen::Isometry3d base_tf =
+      dart::dynamics::FreeJoint::convertToTransform(base);
+  Eigen::Vector3d axle_center = (lwheel_->getCOM() + rwheel_->getCOM()) / 2.0;
+  Eigen::Matrix3d rot =
+      Eigen::AngleAxisd(pitch_change, Eigen::Vector3d::UnitY())
+          .toRotationMatrix();
+  base_tf.linear() = rot * base_tf.linear();
+  base_tf.translation() =
+      axle_center + rot * (base_tf.translation() - axle_center);
+  base_tf.translation()(0) += forward_change;
+  base = dart::dynamics::FreeJoint::convertToPositions(base_tf);
+  for (int i = 0; i < 6; i++) plant_->setPosition(i, base(i));
+
+  // Wheel joints are relative to the base
+  plant_->setPosition(kLWheelDof, wheel_ - spin_ - imu_);
+  plant_->setPosition(kRWheelDof, wheel_ + spin_ - imu_);
+}
+
+//============================================================================
+void SimHardwareInterface::ReadSensors(double dt, SensorSample* sample) {
+  sample->imu = imu_;
+  sample->imu_speed = imu_speed_;
+  sample->amc_pos[0] = wheel_ - spin_ - imu_;
+  sample->amc_pos[1] = wheel_ + spin_ - imu_;
+  sample->amc_vel[0] = wheel_speed_ - spin_speed_ - imu_speed_;
+  sample->amc_vel[1] = wheel_speed_ + spin_speed_ - imu_speed_;
+  sample->waist_pos[0] = plant_->getPosition(kWaistDof);
+  sample->waist_pos[1] = -sample->waist_pos[0];
+  sample->time = time_;
+  sample->num_dofs = plant_->getNumDofs();
+  for (int i = 0; i < sample->num_dofs; i++) {
+    sample->q[i] = plant_->getPosition(i);
+    robot_->setPosition(i, sample->q[i]);
+  }
+}
+
+//============================================================================
+void SimHardwareInterface::SetWheelCurrents(const double* currents) {
+  currents_[0] = currents[0];
+  currents_[1] = currents[1];
+}
+
+//============================================================================
+void SimHardwareInterface::HaltArm(Side side) { arm_mode_[side] = kHalted; }
+
+//============================================================================
+void SimHardwareInterface::ResetArm(Side side) {
+  arm_mode_[side] = kVelocity;
+  for (int i = 0; i < 7; i++) arm_command_[side][i] = 0.0;
+}
+
+//============================================================================
+void SimHardwareInterface::SetArmVelocities(Side side, const double* dq) {
+  if (arm_mode_[side] == kHalted) return;
+  arm_mode_[side] = kVelocity;
+  for (int i = 0; i < 7; i++) arm_command_[side][i] = dq[i];
+}
+
+//============================================================================
+void SimHardwareInterface::SetArmPositions(Side side, const double* q) {
+  if (arm_mode_[side] == kHalted) return;
+  arm_mode_[side] = kPosition;
+  for (int i = 0; i < 7; i++) arm_command_[side][i] = q[i];
+}
+
+//============================================================================
+void SimHardwareInterface::SetWaistMode(Somatic__WaistMode mode) {
+  waist_mode_ = mode;
+}
+
+//============================================================================
+void SimHardwareInterface::HaltTorso() { torso_halted_ = true; }
+
+//============================================================================
+void SimHardwareInterface::ResetTorso() {
+  torso_halted_ = false;
+  torso_velocity_ = 0.0;
+}
+
+//============================================================================
+void SimHardwareInterface::SetTorsoVelocity(double dq) {
+  if (!torso_halted_) torso_velocity_ = dq;
+}
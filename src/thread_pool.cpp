@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file thread_pool.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Runs independent tasks on all cores with work stealing
+ */
+
+#include "balancing/thread_pool.h"
+
+#include <pthread.h>  // pthread_: create(), join(), mutex_*, cond_*
+#include <unistd.h>   // sysconf()
+
+#include <functional>  // std::function
+
+/* ************************************************************************* */
+ThreadPool::ThreadPool(int num_threads)
+    : next_queue_(0),
+      num_queued_(0),
+      num_unfinished_(0),
+      num_steals_(0),
+      stopping_(false) {
+  if (num_threads <= 0) num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (num_threads <= 0) num_threads = 1;
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&work_cond_, NULL);
+  pthread_cond_init(&done_cond_, NULL);
+
+  // All queues exist before any worker may try to steal from them
+  for (int i = 0; i < num_threads; i++) {
+    Worker* worker = new Worker;
+    worker->pool = this;
+    worker->index = i;
+    pthread_mutex_init(&worker->mutex, NULL);
+    workers_.push_back(worker);
+  }
+  for (int i = 0; i < num_threads; i++)
+    pthread_create(&workers_[i]->thread, NULL, &ThreadPool::Run, workers_[i]);
+}
+
+/* ************************************************************************* */
+ThreadPool::~ThreadPool() {
+  pthread_mutex_lock(&mutex_);
+  stopping_ = true;
+  pthread_cond_broadcast(&work_cond_);
+  pthread_mutex_unlock(&mutex_);
+
+  // Workers still running may steal from the queue of any other, so no queue
+  // is destroyed before all of them have stopped
+  for (size_t i = 0; i < workers_.size(); i++)
+    pthread_join(workers_[i]->thread, NULL);
+  for (size_t i = 0; i < workers_.size(); i++) {
+    pthread_mutex_destroy(&workers_[i]->mutex);
+    delete workers_[i];
+  }
+  pthread_cond_destroy(&done_cond_);
+  pthread_cond_destroy(&work_cond_);
+  pthread_mutex_destroy(&mutex_);
+}
+
+/* ************************************************************************* */
+void ThreadPool::Submit(const std::function<void()>& task) {
+  num_unfinished_.fetch_add(1);
+
+  // Count the task before it can be popped, so that the worker running it
+  // never takes num_queued_ below zero. Counting under mutex_ keeps a worker
+  // going to sleep from missing the task
+  pthread_mutex_lock(&mutex_);
+  num_queued_.fetch_add(1);
+  pthread_mutex_unlock(&mutex_);
+
+  Worker* worker = workers_[next_queue_.fetch_add(1) % workers_.size()];
+  pthread_mutex_lock(&worker->mutex);
+  worker->tasks.push_back(task);
+  pthread_mutex_unlock(&worker->mutex);
+
+  pthread_mutex_lock(&mutex_);
+  pthread_cond_signal(&work_cond_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+/* ************************************************************************* */
+void ThreadPool::Wait() {
+  pthread_mutex_lock(&mutex_);
+  while (num_unfinished_.load() > 0) pthread_cond_wait(&done_cond_, &mutex_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+/* ************************************************************************* */
+bool ThreadPool::Pop(int index, std::function<void()>* task) {
+  Worker* worker = workers_[index];
+  bool found = false;
+  pthread_mutex_lock(&worker->mutex);
+  if (!worker->tasks.empty()) {
+    *task = worker->tasks.back();
+    worker->tasks.pop_back();
+    found = true;
+  }
+  pthread_mutex_unlock(&worker->mutex);
+  return found;
+}
+
+/* ************************************************************************* */
+bool ThreadPool::Steal(int index, std::function<void()>* task) {
+  for (size_t i = 1; i < workers_.size(); i++) {
+    Worker* victim = workers_[(index + i) % workers_.size()];
+    bool found = false;
+    pthread_mutex_lock(&victim->mutex);
+    if (!victim->tasks.empty()) {
+      *task = victim->tasks.front();
+      victim->tasks.pop_front();
+      found = true;
+    }
+    pthread_mutex_unlock(&victim->mutex);
+    if (found) {
+      num_steals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+/* ************************************************************************* */
+void* ThreadPool::Run(void* arg) {
+  Worker* worker = (Worker*)arg;
+  ThreadPool* pool = worker->pool;
+  std::function<void()> task;
+  while (true) {
+    if (pool->Pop(worker->index, &task) || pool->Steal(worker->index, &task)) {
+      pool->num_queued_.fetch_sub(1);
+      task();
+      task = std::function<void()>();
+
+      // Wait() checks the count under mutex_, so taking it here guarantees
+      // the waiter is either not yet checking or already waiting
+      if (pool->num_unfinished_.fetch_sub(1) == 1) {
+        pthread_mutex_lock(&pool->mutex_);
+        pthread_cond_broadcast(&pool->done_cond_);
+        pthread_mutex_unlock(&pool->mutex_);
+      }
+      continue;
+    }
+
+    // Nothing to run: sleep until a task is queued or the pool is destroyed
+    pthread_mutex_lock(&pool->mutex_);
+    while (pool->num_queued_.load() == 0 && !pool->stopping_)
+      pthread_cond_wait(&pool->work_cond_, &pool->mutex_);
+    bool stop = (pool->stopping_ && pool->num_queued_.load() == 0);
+    pthread_mutex_unlock(&pool->mutex_);
+    if (stop) break;
+  }
+  return NULL;
+}
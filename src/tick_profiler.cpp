@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file tick_profiler.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Measures how long each stage of an iteration of the main loop takes
+ */
+
+#include "balancing/tick_profiler.h"
+
+#include <assert.h>  // assert()
+#include <stdint.h>  // uint64_t
+#include <stdio.h>   // printf()
+#include <time.h>    // clock_gettime()
+
+#include <cstring>  // memset()
+
+namespace {
+// Nanoseconds from a to b
+uint64_t ElapsedNanoseconds(const struct timespec& a,
+                            const struct timespec& b) {
+  return (uint64_t)((b.tv_sec - a.tv_sec) * 1000000000L +
+                    (b.tv_nsec - a.tv_nsec));
+}
+}  // namespace
+
+//============================================================================
+void LatencyHistogram::Reset() {
+  memset(buckets_, 0, sizeof(buckets_));
+  count_ = 0;
+  sum_ = 0;
+  max_ = 0;
+}
+
+//============================================================================
+int LatencyHistogram::BucketIndex(uint64_t ns) {
+  if (ns < (uint64_t)kSubBuckets) return (int)ns;
+
+  // Position of the leading bit decides the power-of-two range and the next
+  // kSubBucketBits bits decide the linear sub-bucket within it
+  int exponent = 63 - __builtin_clzll(ns);
+  if (exponent >= kMaxExponent) return kNumBuckets - 1;
+  int sub_bucket = (int)(ns >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+//============================================================================
+uint64_t LatencyHistogram::BucketUpperBound(int index) {
+  if (index < kSubBuckets) return (uint64_t)index;
+  int exponent = index / kSubBuckets + kSubBucketBits - 1;
+  uint64_t sub_bucket = (uint64_t)(index % kSubBuckets);
+  int shift = exponent - kSubBucketBits;
+  return ((kSubBuckets + sub_bucket + 1) << shift) - 1;
+}
+
+//============================================================================
+void LatencyHistogram::Record(uint64_t ns) {
+  buckets_[BucketIndex(ns)]++;
+  count_++;
+  sum_ += ns;
+  if (ns > max_) max_ = ns;
+}
+
+//============================================================================
+uint64_t LatencyHistogram::Percentile(double fraction) const {
+  if (count_ == 0) return 0;
+  uint64_t target = (uint64_t)(fraction * count_ + 0.5);
+  if (target < 1) target = 1;
+  uint64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i];
+    if (seen >= target) {
+      uint64_t bound = BucketUpperBound(i);
+      return (bound < max_ ? bound : max_);
+    }
+  }
+  return max_;
+}
+
+//============================================================================
+TickProfiler::TickProfiler(const char* const* stage_names, int num_stages)
+    : stage_names_(stage_names), num_stages_(num_stages) {
+  assert(num_stages <= kMaxStages && "Too many stages for the profiler");
+  clock_gettime(CLOCK_MONOTONIC, &tick_start_);
+  last_mark_ = tick_start_;
+}
+
+//============================================================================
+void TickProfiler::BeginTick() {
+  clock_gettime(CLOCK_MONOTONIC, &tick_start_);
+  last_mark_ = tick_start_;
+}
+
+//============================================================================
+void TickProfiler::EndStage(int stage) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  stages_[stage].Record(ElapsedNanoseconds(last_mark_, now));
+  last_mark_ = now;
+}
+
+//============================================================================
+void TickProfiler::EndTick() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  tick_.Record(ElapsedNanoseconds(tick_start_, now));
+  last_mark_ = now;
+}
+
+//============================================================================
+void TickProfiler::Reset() {
+  for (int i = 0; i < num_stages_; i++) stages_[i].Reset();
+  tick_.Reset();
+}
+
+//============================================================================
+void TickProfiler::Print() const {
+  printf("\n%-22s %10s %10s %10s %10s %10s %10s\n", "stage (us)", "count",
+         "mean", "p50", "p99", "p99.9", "max");
+  for (int i = 0; i <= num_stages_; i++) {
+    const LatencyHistogram& h = (i < num_stages_ ? stages_[i] : tick_);
+    printf("%-22s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+           (i < num_stages_ ? stage_names_[i] : "whole tick"),
+           (unsigned long long)h.count(), h.mean() * 1e-3,
+           h.Percentile(0.5) * 1e-3, h.Percentile(0.99) * 1e-3,
+           h.Percentile(0.999) * 1e-3, h.max() * 1e-3);
+  }
+  printf("\n");
+}
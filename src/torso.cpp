@@ -42,35 +42,26 @@
 
 #include "balancing/torso.h"
 
-#include <somatic.h>
-#include <somatic/daemon.h>
-#include <somatic/motor.h>
-
-#include <kore.hpp>
-#include <kore/util.hpp>
+#include "balancing/hardware_interface.h"
 
 /* *********************************************************************************************
  */
 /// Handles the torso commands if we are using joystick
-void ControlTorso(somatic_d_t& daemon_cx, TorsoState& torso_state,
-                  Krang::Hardware* krang) {
-  static TorsoState::TorsoMode last_mode = TorsoState::kStop;
-
+void ControlTorso(TorsoState& torso_state, HardwareInterface* hw) {
   // if torso needs to be reset
-  if (last_mode == TorsoState::kStop && torso_state.mode == TorsoState::kMove) {
-    somatic_motor_reset(&daemon_cx, krang->torso);
-    last_mode = torso_state.mode;
+  if (torso_state.last_mode == TorsoState::kStop &&
+      torso_state.mode == TorsoState::kMove) {
+    hw->ResetTorso();
+    torso_state.last_mode = torso_state.mode;
     return;
   }
 
   // Control based on the desired state
   if (torso_state.mode == TorsoState::kStop)
-    somatic_motor_halt(&daemon_cx, krang->torso);
+    hw->HaltTorso();
 
   else {
-    double dq[] = {torso_state.command_val};
-    somatic_motor_cmd(&daemon_cx, krang->torso,
-                      SOMATIC__MOTOR_PARAM__MOTOR_VELOCITY, dq, 1, NULL);
+    hw->SetTorsoVelocity(torso_state.command_val);
   }
-  last_mode = torso_state.mode;
+  torso_state.last_mode = torso_state.mode;
 }
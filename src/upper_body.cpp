@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @file upper_body.cpp
+ * @author agent
+ * @date Oct 16, 2026
+ * @brief Controls the arms, waist and torso at a lower rate than the balancing
+ * loop
+ */
+
+#include "balancing/upper_body.h"
+
+#include <pthread.h>  // pthread_create(), pthread_join()
+
+#include <iostream>  // std::cout, std::endl
+
+#include <somatic.pb-c.h>  // Somatic__WaistMode, SOMATIC__WAIST_MODE__STOP
+
+#include "balancing/arms.h"                // ArmControl
+#include "balancing/balancing_config.h"    // BalancingConfig
+#include "balancing/hardware_interface.h"  // HardwareInterface
+#include "balancing/loop_timer.h"          // LoopTimer
+#include "balancing/torso.h"               // TorsoState, ControlTorso()
+#include "balancing/waist.h"               // ControlWaist()
+
+/* ************************************************************************* */
+UpperBodyExecutor::UpperBodyExecutor(HardwareInterface* hw,
+                                     BalancingConfig& params, double rate)
+    : hw_(hw),
+      divider_(params.upperBodyRateDivider > 1 ? params.upperBodyRateDivider
+                                               : 1),
+      arm_control_(hw, params),
+      waist_mode_(SOMATIC__WAIST_MODE__STOP),
+      num_lock_unlock_events_(0),
+      num_ticks_(0),
+      running_(false) {
+  rate_ = rate / divider_;
+
+  // Nothing moves until the first commands are published
+  Command command;
+  command.arm_mode = ArmControl::kStop;
+  command.preset_config_num = 0;
+  for (int i = 0; i < 7; i++) command.arm_command_vals[i] = 0.0;
+  command.num_lock_unlock_events = 0;
+  command.waist_mode = SOMATIC__WAIST_MODE__STOP;
+  command.torso_mode = TorsoState::kStop;
+  command.torso_command_val = 0.0;
+  command_.Store(command);
+}
+
+/* ************************************************************************* */
+UpperBodyExecutor::~UpperBodyExecutor() { Stop(); }
+
+/* ************************************************************************* */
+void UpperBodyExecutor::Start() {
+  if (running_.load() || rate_ <= 0.0) return;
+  running_.store(true);
+  pthread_create(&thread_, NULL, &UpperBodyExecutor::Run, this);
+}
+
+/* ************************************************************************* */
+void UpperBodyExecutor::Stop() {
+  if (!running_.load()) return;
+  running_.store(false);
+  pthread_join(thread_, NULL);
+}
+
+/* ************************************************************************* */
+void UpperBodyExecutor::Publish(const ArmControl& arm_control,
+                                Somatic__WaistMode waist_mode,
+                                const TorsoState& torso_state) {
+  Command command;
+  command.arm_mode = arm_control.mode;
+  command.preset_config_num = arm_control.preset_config_num;
+  for (int i = 0; i < 7; i++)
+    command.arm_command_vals[i] = arm_control.command_vals[i];
+  command.num_lock_unlock_events = arm_control.num_lock_unlock_events;
+  command.waist_mode = waist_mode;
+  command.torso_mode = torso_state.mode;
+  command.torso_command_val = torso_state.command_val;
+  command_.Store(command);
+}
+
+/* ************************************************************************* */
+void UpperBodyExecutor::Tick() {
+  // If the balancing thread is publishing right now, the previous commands
+  // are kept for another tick
+  Command command;
+  if (command_.TryLoad(&command)) {
+    arm_control_.mode = (ArmControl::ArmMode)command.arm_mode;
+    arm_control_.preset_config_num = command.preset_config_num;
+    for (int i = 0; i < 7; i++)
+      arm_control_.command_vals[i] = command.arm_command_vals[i];
+    while (num_lock_unlock_events_ < command.num_lock_unlock_events) {
+      arm_control_.LockUnlockEvent();
+      num_lock_unlock_events_++;
+    }
+    waist_mode_ = (Somatic__WaistMode)command.waist_mode;
+    torso_state_.mode = (TorsoState::TorsoMode)command.torso_mode;
+    torso_state_.command_val = command.torso_command_val;
+  }
+
+  arm_control_.ControlArms();
+  ControlWaist(waist_mode_, hw_);
+  ControlTorso(torso_state_, hw_);
+  num_ticks_.fetch_add(1);
+}
+
+/* ************************************************************************* */
+void* UpperBodyExecutor::Run(void* arg) {
+  UpperBodyExecutor* executor = (UpperBodyExecutor*)arg;
+
+  LoopTimer loop_timer(executor->rate_);
+  loop_timer.Start();
+  while (executor->running_.load()) {
+    loop_timer.Wait();
+    executor->Tick();
+  }
+  std::cout << "upper body ticks: " << executor->num_ticks()
+            << ", overruns: " << loop_timer.num_overruns() << std::endl;
+  return NULL;
+}